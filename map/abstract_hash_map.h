@@ -1,50 +1,170 @@
 #pragma once
 
 #include "abstract_map.h"
+#include "hash_map_stats.h"
+#include "table_sizing.h"
+
+#include <cmath>                    // defines std::ceil
+#include <iterator>                 // defines std::iterator_traits, std::distance
+#include <stdexcept>
+#include <type_traits>              // defines std::is_base_of
+#include <vector>
 
 namespace dsac::map {
 
-template <typename Key, typename Value, typename Hash>
-class AbstractHashMap : public AbstractMap<Key,Value> {
+/// Hints that the memory at the given address will soon be read (a no-op if unsupported)
+inline void prefetch(const void* p) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+template <typename Key, typename Value, typename Hash, typename Sizing = PrimeSizing>
+class AbstractHashMap : public AbstractMap<Key,Value>, protected HashMapStats {
   protected:
     typedef AbstractMap<Key,Value> Base;
     
   public:
-    using typename Base::Entry, typename Base::const_iterator, Base::begin, Base::end;
+    using typename Base::Entry, typename Base::const_iterator;
+    using Base::begin, Base::end;
     
   protected:
     Hash hash;                                           // hash function
     int sz{0};                                           // total number of entries
-    int table_sz{17};                                    // current number of buckets
+    int table_sz{Sizing::initial_size()};                // current number of buckets
+    float max_load{0.5};                                 // table grows when sz > max_load * table_sz
+
+    static constexpr int BATCH{16};                      // keys hashed and prefetched together by find_batch
+
+    // compute compressed hash function on key k, as determined by the sizing policy
+    int get_hash(const Key& k) const { return Sizing::index(hash(k), table_sz); }
 
-    // compute compressed hash function on key k with simple division method
-    int get_hash(const Key& k) const { return hash(k) % table_sz; }
+    // number of buckets needed to store n entries without exceeding the maximum load factor
+    int buckets_for(int n) const { return Sizing::size_for(std::ceil(n / max_load)); }
 
-    // Change table size and rehash all entries
-    void resize(int new_table_size) {
-        std::vector<Entry> buffer;                       // temporary copy of all entries
-        for (Entry e : *this)
-            buffer.push_back(e);
+    // Change table size and rehash all entries (subclasses may provide a more efficient approach)
+    virtual void resize(int new_table_size) {
+        std::vector<Entry> buffer;                       // temporary storage for all entries
+        buffer.reserve(sz);
+        for (const_iterator walk{begin()}; walk != end(); ++walk)
+            buffer.push_back(std::move(const_cast<Entry&>(*walk)));   // old table is discarded anyway
         table_sz = new_table_size;
         create_table();                                  // based on updated capacity
         sz = 0;                                          // will be recomputed while reinserting entries
-        for (Entry e : buffer)
-            put(e.key(), e.value());                     // reinsert into this map
+        for (Entry& e : buffer)
+            bucket_put(get_hash(e.key()), Base::release_key(e), std::move(e.value()));
+    }
+
+    // Calls resize, recording the event (if statistics are enabled)
+    void timed_resize(int new_table_size) {
+        auto timer{this->time_resize()};
+        resize(new_table_size);
+    }
+
+    // Grows the table, if necessary, so that one more entry can be added without exceeding
+    // the maximum load factor. Returns true if the table was resized.
+    bool make_room() {
+        if (sz + 1 <= max_load * table_sz)
+            return false;
+        timed_resize(Sizing::size_for(2 * table_sz));    // roughly double the table size
+        return true;
     }
 
+    // Returns the hash of key k for a put, first growing the table if k is new and one more
+    // entry would exceed the maximum load factor. Overwriting an existing value never causes
+    // a resize; the extra search for k is made only when the table is at its limit.
+    int make_room_for(const Key& k) {
+        if (sz + 1 > max_load * table_sz && bucket_find(get_hash(k), k) == end())
+            make_room();
+        return get_hash(k);
+    }
+
+    // Throws invalid_argument unless the table can operate with a maximum load factor of f
+    // (subclasses may impose further limits)
+    virtual void check_max_load(float f) const {
+        if (!(f > 0))
+            throw std::invalid_argument("max load factor must be positive");
+    }
+
+    // Hints that bucket h will soon be searched (subclasses may prefetch its memory)
+    virtual void bucket_prefetch(int h) const { (void)h; }
+
     //---------- pure virtual functions -----------
     virtual void create_table() = 0;              // creates an empty table having length equal to num_buckets;
     virtual const_iterator bucket_find(int h, const Key& k) const = 0;          // searches for k in bucket h
     virtual const_iterator bucket_put(int h, const Key& k, const Value& v) = 0; // calls put(k,v) on bucket h
+    virtual const_iterator bucket_put(int h, Key&& k, Value&& v) = 0;           // same, moving k and v
     virtual const_iterator bucket_erase(int h, const_iterator loc) = 0;         // calls erase(v) on bucket h
     
   public:
     /// Returns the number of entries in the map
     int size() const { return sz; }
 
+    /// Returns the current number of buckets
+    int bucket_count() const { return table_sz; }
+
+    /// Returns the average number of entries per bucket
+    float load_factor() const { return float(sz) / table_sz; }
+
+    /// Returns the statistics recorded by this map (which are empty unless DSAC_MAP_STATS is defined)
+    const HashMapStats& stats() const { return *this; }
+
+    /// Returns the load factor that the table is not allowed to exceed
+    float max_load_factor() const { return max_load; }
+
+    /// Sets the load factor that the table is not allowed to exceed, resizing if necessary.
+    /// Throws invalid_argument if f is not positive, or is too large for the kind of table
+    /// (as with open addressing, which requires f < 1).
+    void max_load_factor(float f) {
+        check_max_load(f);
+        max_load = f;
+        if (sz > max_load * table_sz)
+            timed_resize(buckets_for(sz));
+    }
+
+    /// Ensures that the table has room for n entries without any further resizing
+    void reserve(int n) {
+        int needed{buckets_for(n)};
+        if (needed > table_sz)
+            timed_resize(needed);
+    }
+
     /// Returns a const_iterator to the entry with a given key, or end() if no such entry exists
     const_iterator find(const Key& k) const { return bucket_find(get_hash(k), k); }
 
+    /// Writes to out a const_iterator for each key in the range [first, last), as given by
+    /// find. Keys are processed in groups: all buckets of a group are prefetched before any
+    /// is searched, so that the memory accesses for different keys may overlap.
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+        const Key* keys[BATCH];
+        int h[BATCH];
+        while (first != last) {
+            int n{0};
+            for ( ; n < BATCH && first != last; ++n, ++first) {
+                keys[n] = &*first;
+                h[n] = get_hash(*keys[n]);
+                bucket_prefetch(h[n]);
+            }
+            for (int j = 0; j < n; j++)
+                *out++ = bucket_find(h[j], *keys[j]);
+        }
+        return out;
+    }
+
+    /// Adds each (key, value) pair in the range [first, last), as given by put. When the
+    /// number of pairs can be determined in advance, the table is resized at most once.
+    template <typename InputIt>
+    void build_from(InputIt first, InputIt last) {
+        typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+        if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value)
+            reserve(sz + std::distance(first, last));
+        for ( ; first != last; ++first)
+            put(first->first, first->second);
+    }
+
     /// Removes the entry indicated by the given iterator, and returns iterator to next entry in iteration order
     const_iterator erase(const_iterator loc) {
         int h{get_hash(loc->key())};
@@ -54,10 +174,40 @@ class AbstractHashMap : public AbstractMap<Key,Value> {
     /// Associates given key with given value. If key already exists previous value is overwritten.
     /// Returns an iterator to the entry associated with the key
     const_iterator put(const Key& k, const Value& v) {
-        const_iterator result{bucket_put(get_hash(k), k, v)};
-        if (sz > table_sz / 2)                             // keep load factor <= 0.5
-            resize(2 * table_sz - 1);                      // will be pow(2,j) + 1 for some j
-        return result;
+        int h{make_room_for(k)};                           // keep load factor <= max_load
+        return bucket_put(h, k, v);
+    }
+
+    /// Same as above, but moving the key and value into the map
+    const_iterator put(Key&& k, Value&& v) {
+        int h{make_room_for(k)};
+        return bucket_put(h, std::move(k), std::move(v));
+    }
+
+    /// Inserts an entry with key k and a value constructed from the remaining arguments,
+    /// unless k is already in the map (in which case nothing is constructed or changed).
+    /// Returns an iterator to the entry with key k, and true if a new entry was inserted.
+    template <typename... Args>
+    std::pair<const_iterator,bool> try_emplace(const Key& k, Args&&... args) {
+        int h{get_hash(k)};
+        const_iterator it{bucket_find(h, k)};
+        if (it != end())
+            return {it, false};
+        if (make_room())
+            h = get_hash(k);                               // table size has changed
+        return {bucket_put(h, Key(k), Value(std::forward<Args>(args)...)), true};
+    }
+
+    /// Same as above, but moving the key into the new entry (if one is inserted)
+    template <typename... Args>
+    std::pair<const_iterator,bool> try_emplace(Key&& k, Args&&... args) {
+        int h{get_hash(k)};
+        const_iterator it{bucket_find(h, k)};
+        if (it != end())
+            return {it, false};
+        if (make_room())
+            h = get_hash(k);                               // table size has changed
+        return {bucket_put(h, std::move(k), Value(std::forward<Args>(args)...)), true};
     }
 };
 
@@ -1,6 +1,16 @@
 #pragma once
 
+#include <cstddef>                  // defines std::max_align_t
+#include <new>                      // defines placement new
 #include <stdexcept>
+#include <utility>                  // defines std::move, std::forward, std::pair
+
+/// Number of bytes reserved within each const_iterator for its representation.
+/// Any iter_rep that fits is constructed in place, avoiding a heap allocation;
+/// compiling with -DDSAC_ITER_REP_CAPACITY=0 forces the original heap-based behavior.
+#ifndef DSAC_ITER_REP_CAPACITY
+#define DSAC_ITER_REP_CAPACITY (4 * sizeof(void*))
+#endif
 
 namespace dsac::map {
 
@@ -16,7 +26,9 @@ class AbstractMap {
         Value v;
 
       public:
-        Entry(const Key& k = Key(), const Value& v = Value()) : k(k), v(v) {}
+        Entry() : k(), v() {}
+        Entry(const Key& k, const Value& v = Value()) : k(k), v(v) {}
+        Entry(Key&& k, Value&& v) : k(std::move(k)), v(std::move(v)) {}
         const Key& key() const { return k; }       // read-only access
         const Value& value() const { return v; }   // read-only access
         Value& value() { return v; }               // allow value to be changed
@@ -28,11 +40,29 @@ class AbstractMap {
       public:
         virtual const Entry& entry() const = 0;
         virtual void advance() = 0;
+        virtual void retreat() { throw std::logic_error("iterator cannot be decremented"); }
         virtual bool equals(const abstract_iter_rep* other) const = 0;
-        virtual abstract_iter_rep* clone() const = 0;
+        virtual abstract_iter_rep* clone_into(void* buffer) const = 0;   // copy into buffer (if it fits)
         virtual ~abstract_iter_rep() {}
     }; //------ end of abstract_iter_rep ----------
 
+    static constexpr std::size_t REP_CAPACITY{DSAC_ITER_REP_CAPACITY};
+
+    // Concrete representations inherit from iter_rep_base<Rep>, which provides the
+    // cloning logic: the copy is built within the given buffer when Rep is small
+    // enough, and on the heap otherwise.
+    template <typename Rep>
+    class iter_rep_base : public abstract_iter_rep {
+      public:
+        abstract_iter_rep* clone_into(void* buffer) const {
+            const Rep& self{static_cast<const Rep&>(*this)};
+            if (sizeof(Rep) <= REP_CAPACITY && alignof(Rep) <= alignof(std::max_align_t))
+                return new (buffer) Rep(self);
+            else
+                return new Rep(self);
+        }
+    }; //------ end of iter_rep_base ----------
+
   public:
     //---------- const_iterator ----------
     class const_iterator {
@@ -40,22 +70,36 @@ class AbstractMap {
 
       private:
         abstract_iter_rep* rep{nullptr};
+        alignas(std::max_align_t) unsigned char buffer[REP_CAPACITY > 0 ? REP_CAPACITY : 1];
+
+        bool is_local() const { return rep == reinterpret_cast<const abstract_iter_rep*>(buffer); }
+        void release() {
+            if (is_local())
+                rep->~abstract_iter_rep();           // destroy in place; no memory to free
+            else
+                delete rep;
+            rep = nullptr;
+        }
         
       public:
         const Entry& operator*() const { return rep->entry(); }
         const Entry* operator->() const { return &rep->entry(); }
         const_iterator& operator++() { rep->advance(); return *this; }
         const_iterator operator++(int) { const_iterator temp{*this}; rep->advance(); return temp; }
+        const_iterator& operator--() { rep->retreat(); return *this; }         // for ordered maps only
+        const_iterator operator--(int) { const_iterator temp{*this}; rep->retreat(); return temp; }
         bool operator==(const const_iterator& other) const { return rep->equals(other.rep); }
         bool operator!=(const const_iterator& other) const { return !rep->equals(other.rep); }
         
-        const_iterator(abstract_iter_rep* r = nullptr) : rep{r} {}
-        const_iterator(const const_iterator& other) : rep{other.rep->clone()} {}
-        ~const_iterator() { delete rep; }
+        const_iterator(abstract_iter_rep* r = nullptr) : rep{r} {}      // adopts a heap-allocated rep
+        const_iterator(const const_iterator& other) {
+            if (other.rep != nullptr) rep = other.rep->clone_into(buffer);
+        }
+        ~const_iterator() { release(); }
         const_iterator& operator=(const const_iterator& other) {
-            if (this != &other and rep != nullptr) {
-                delete rep;
-                rep = other.rep->clone();
+            if (this != &other) {
+                release();
+                if (other.rep != nullptr) rep = other.rep->clone_into(buffer);
             }
             return *this;
         }
@@ -63,10 +107,29 @@ class AbstractMap {
     }; //------ end of const_iterator ----------
     
   protected:
-    abstract_iter_rep* get_rep(const_iterator iter) const { return iter.rep; }
+    abstract_iter_rep* get_rep(const const_iterator& iter) const { return iter.rep; }
+
+    // Returns a const_iterator holding a copy of the given representation
+    template <typename Rep>
+    static const_iterator make_iterator(const Rep& r) {
+        const_iterator result;
+        result.rep = r.clone_into(result.buffer);
+        return result;
+    }
+
     void update_value(const Entry& e, const Value& v) {
         const_cast<Entry&>(e).v = v;
     }
+    void update_value(const Entry& e, Value&& v) {
+        const_cast<Entry&>(e).v = std::move(v);
+    }
+
+    // Called after upsert modifies the value of the entry at it in place, for subclasses
+    // that maintain data derived from values
+    virtual void value_updated(const const_iterator& it) { (void)it; }
+
+    // Allows the key of an entry that is about to be discarded to be moved elsewhere
+    static Key&& release_key(Entry& e) { return std::move(e.k); }
 
   public:
     //---------- concrete functions -----------
@@ -88,6 +151,48 @@ class AbstractMap {
         return it->value();
     }
 
+    /// Inserts an entry with key k and a value constructed from the remaining arguments,
+    /// unless k is already in the map (in which case nothing is constructed or changed).
+    /// Returns an iterator to the entry with key k, and true if a new entry was inserted.
+    template <typename... Args>
+    std::pair<const_iterator,bool> try_emplace(const Key& k, Args&&... args) {
+        const_iterator it{find(k)};
+        if (it != end())
+            return {it, false};
+        return {put(Key(k), Value(std::forward<Args>(args)...)), true};
+    }
+
+    /// Same as above, but moving the key into the new entry (if one is inserted)
+    template <typename... Args>
+    std::pair<const_iterator,bool> try_emplace(Key&& k, Args&&... args) {
+        const_iterator it{find(k)};
+        if (it != end())
+            return {it, false};
+        return {put(std::move(k), Value(std::forward<Args>(args)...)), true};
+    }
+
+    /// Associates given key with given value, as with put, but also returns true if a new
+    /// entry was inserted, or false if an existing value was overwritten
+    template <typename K, typename V>
+    std::pair<const_iterator,bool> insert_or_assign(K&& k, V&& v) {
+        int old_size{size()};
+        const_iterator it{put(std::forward<K>(k), std::forward<V>(v))};
+        return {it, size() > old_size};
+    }
+
+    /// If key k is in the map, calls update(value) to modify its value in place; otherwise
+    /// inserts k with the given initial value. An existing key is found with a single
+    /// search (unlike calling contains, at, and put in turn). Returns an iterator to the entry.
+    template <typename K, typename F>
+    const_iterator upsert(K&& k, const Value& initial, F update) {
+        const_iterator it{find(k)};
+        if (it == end())
+            return put(Key(std::forward<K>(k)), Value(initial));
+        update(const_cast<Entry&>(*it).v);
+        value_updated(it);
+        return it;
+    }
+
     /// Erases entry with given key (if one exists)
     /// Returns true if an entry was removed, false otherwise
     bool erase(const Key& k) {
@@ -106,6 +211,7 @@ class AbstractMap {
     virtual const_iterator end() const = 0;
     virtual const_iterator find(const Key& k) const = 0;
     virtual const_iterator put(const Key& k, const Value& v) = 0;
+    virtual const_iterator put(Key&& k, Value&& v) = 0;           // moves the key and value into the map
     virtual const_iterator erase(const_iterator loc) = 0;
 };
 
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <vector>
+
+#include "searchtree/avl_tree_map.h"
+#include "searchtree/b_tree_map.h"
+#include "searchtree/red_black_tree_map.h"
+#include "searchtree/splay_tree_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::search_tree;
+
+/// Returns the nanoseconds per operation since start, for the given number of operations
+double per_operation(high_resolution_clock::time_point start, int operations) {
+    auto stop = high_resolution_clock::now();
+    return double(duration_cast<nanoseconds>(stop-start).count()) / operations;
+}
+
+/// Inserts the given keys (in the given order), then performs a find for each query (half
+/// of which are unsuccessful), iterates through the map, and erases every key, reporting
+/// the time per operation of each phase
+template <typename Map>
+void experiment(const string& name, const vector<int>& keys, const vector<int>& queries) {
+    long checksum{0};
+    Map map;
+
+    auto start = high_resolution_clock::now();
+    for (int k : keys)
+        map.put(k, k);
+    double insert{per_operation(start, keys.size())};
+
+    start = high_resolution_clock::now();
+    for (int q : queries) {
+        auto it = map.find(q);
+        if (it != map.end()) checksum += it->value();
+    }
+    double find{per_operation(start, queries.size())};
+
+    start = high_resolution_clock::now();
+    for (const auto& e : map)
+        checksum -= e.value();
+    double scan{per_operation(start, keys.size())};
+
+    start = high_resolution_clock::now();
+    for (int k : keys)
+        map.erase(k);
+    double erase{per_operation(start, keys.size())};
+
+    cout << setw(20) << name << fixed << setprecision(1) << setw(9) << insert << setw(9) << find
+         << setw(9) << scan << setw(9) << erase << "  (checksum " << checksum << ")" << endl;
+}
+
+/// The command line arguments set the smallest and largest number of entries (which are
+/// multiplied by 10 in between); keys are distinct even numbers in random order, and there
+/// are as many queries as entries.
+int main(int argc, char* argv[]) {
+    int smallest{argc >= 2 ? stoi(argv[1]) : 1000};          // fewest entries (default 1000)
+    int largest{argc >= 3 ? stoi(argv[2]) : 1000000};        // most entries (default 1000000)
+
+    for (int n = smallest; n <= largest; n *= 10) {
+        mt19937 rng(n);
+        vector<int> keys, queries;
+        for (int j = 0; j < n; j++)
+            keys.push_back(2 * j);
+        shuffle(keys.begin(), keys.end(), rng);
+        for (int j = 0; j < n; j++)
+            queries.push_back(rng() % (2 * n));
+
+        cout << endl << n << " entries (nanoseconds per operation):" << endl;
+        cout << setw(20) << "" << setw(9) << "insert" << setw(9) << "find" << setw(9) << "scan" << setw(9) << "erase" << endl;
+        experiment<AVLTreeMap<int,int>>("AVLTreeMap", keys, queries);
+        experiment<RedBlackTreeMap<int,int>>("RedBlackTreeMap", keys, queries);
+        experiment<SplayTreeMap<int,int>>("SplayTreeMap", keys, queries);
+        experiment<BTreeMap<int,int,less<int>,8>>("BTreeMap (order 8)", keys, queries);
+        experiment<BTreeMap<int,int,less<int>,32>>("BTreeMap (order 32)", keys, queries);
+        experiment<BTreeMap<int,int,less<int>,128>>("BTreeMap (order 128)", keys, queries);
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (default arguments):
+
+1000 entries (nanoseconds per operation):
+                       insert     find     scan    erase
+          AVLTreeMap    162.9     97.6     24.2    157.7  (checksum -473486)
+     RedBlackTreeMap    131.5    115.7     30.5    184.6  (checksum -473486)
+        SplayTreeMap    313.1    507.9     29.8    322.2  (checksum -473486)
+  BTreeMap (order 8)    142.5    164.9     17.4    248.4  (checksum -473486)
+ BTreeMap (order 32)    137.6    159.7     15.0    220.8  (checksum -473486)
+BTreeMap (order 128)    119.8    169.8     21.9    191.4  (checksum -473486)
+
+10000 entries (nanoseconds per operation):
+                       insert     find     scan    erase
+          AVLTreeMap    222.6    153.5     26.8    200.1  (checksum -49948612)
+     RedBlackTreeMap    175.1    157.5     28.9    191.7  (checksum -49948612)
+        SplayTreeMap    426.5    415.5     32.0    523.9  (checksum -49948612)
+  BTreeMap (order 8)    179.4    171.2     19.3    248.2  (checksum -49948612)
+ BTreeMap (order 32)    141.0    164.8     16.4    247.9  (checksum -49948612)
+BTreeMap (order 128)    163.7    165.1     16.6    230.4  (checksum -49948612)
+
+100000 entries (nanoseconds per operation):
+                       insert     find     scan    erase
+          AVLTreeMap    523.0    427.4     80.6    471.7  (checksum -5024135102)
+     RedBlackTreeMap    424.5    433.2     77.0    476.3  (checksum -5024135102)
+        SplayTreeMap   1030.1   1380.5    108.7   1183.2  (checksum -5024135102)
+  BTreeMap (order 8)    431.7    362.6     30.3    497.3  (checksum -5024135102)
+ BTreeMap (order 32)    232.7    253.8     21.7    376.2  (checksum -5024135102)
+BTreeMap (order 128)    200.3    204.9     13.6    311.1  (checksum -5024135102)
+
+1000000 entries (nanoseconds per operation):
+                       insert     find     scan    erase
+          AVLTreeMap   1513.3   1475.8    226.6   1499.3  (checksum -499859016512)
+     RedBlackTreeMap   1729.1   1682.7    253.6   1613.6  (checksum -499859016512)
+        SplayTreeMap   3072.8   3506.8    251.8   3706.3  (checksum -499859016512)
+  BTreeMap (order 8)    854.1   1010.6     72.2   1289.1  (checksum -499859016512)
+ BTreeMap (order 32)    476.8    618.6     25.6    742.4  (checksum -499859016512)
+BTreeMap (order 128)    323.5    415.8     15.9    448.2  (checksum -499859016512)
+
+*/
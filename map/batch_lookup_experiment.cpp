@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <utility>
+#include <vector>
+
+#include "chain_hash_map.h"
+#include "probe_hash_map.h"
+#include "robin_hood_hash_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// An output iterator that counts the results written to it that are not end()
+template <typename Map>
+struct FoundCounter {
+    const Map* map;
+    long* count;
+    FoundCounter& operator*() { return *this; }
+    FoundCounter& operator++() { return *this; }
+    FoundCounter operator++(int) { return *this; }
+    FoundCounter& operator=(const typename Map::const_iterator& it) {
+        if (it != map->end()) ++*count;
+        return *this;
+    }
+};
+
+/// Builds a map of n random keys both with repeated put and with build_from, and then
+/// performs m lookups of random keys (half of them present) both with repeated find
+/// and with find_batch, reporting the time for each.
+template <typename Map>
+void experiment(const string& name, int n, int m) {
+    mt19937 rng(n);
+    vector<pair<int,int>> items;
+    for (int j = 0; j < n; j++)
+        items.push_back({static_cast<int>(rng()), j});
+    vector<int> keys;
+    for (int j = 0; j < m; j++)
+        keys.push_back(j % 2 == 0 ? items[rng() % n].first : static_cast<int>(rng()));
+
+    cout << endl << name << ":" << endl;
+
+    auto start = high_resolution_clock::now();
+    Map one_at_a_time;
+    for (const pair<int,int>& p : items)
+        one_at_a_time.put(p.first, p.second);
+    auto stop = high_resolution_clock::now();
+    cout << "put loop    " << setw(6) << duration_cast<milliseconds>(stop-start).count() << " milliseconds" << endl;
+
+    start = high_resolution_clock::now();
+    Map map;
+    map.build_from(items.begin(), items.end());
+    stop = high_resolution_clock::now();
+    cout << "build_from  " << setw(6) << duration_cast<milliseconds>(stop-start).count() << " milliseconds" << endl;
+
+    long found{0};
+    start = high_resolution_clock::now();
+    for (int k : keys)
+        if (map.find(k) != map.end()) found++;
+    stop = high_resolution_clock::now();
+    cout << "find loop   " << setw(6) << duration_cast<milliseconds>(stop-start).count() << " milliseconds"
+         << " (" << found << " found)" << endl;
+
+    found = 0;
+    start = high_resolution_clock::now();
+    map.find_batch(keys.begin(), keys.end(), FoundCounter<Map>{&map, &found});
+    stop = high_resolution_clock::now();
+    cout << "find_batch  " << setw(6) << duration_cast<milliseconds>(stop-start).count() << " milliseconds"
+         << " (" << found << " found)" << endl;
+}
+
+/// The first command line argument sets the number of entries, which should be large
+/// enough that the table does not fit in cache, and the second the number of lookups.
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 2000000};      // entries (default 2000000)
+    int m{argc >= 3 ? stoi(argv[2]) : 4000000};      // lookups (default 4000000)
+
+    experiment<ProbeHashMap<int,int>>("ProbeHashMap", n, m);
+    experiment<ProbeHashMap<int,int,hash<int>,PowerOfTwoSizing>>("ProbeHashMap (power of two)", n, m);
+    experiment<RobinHoodHashMap<int,int>>("RobinHoodHashMap", n, m);
+    experiment<ChainHashMap<int,int>>("ChainHashMap", n, m);
+
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (n=2000000, m=4000000):
+
+ProbeHashMap:
+put loop       275 milliseconds
+build_from     149 milliseconds
+find loop      380 milliseconds (2000940 found)
+find_batch     232 milliseconds (2000940 found)
+
+ProbeHashMap (power of two):
+put loop       170 milliseconds
+build_from      94 milliseconds
+find loop      332 milliseconds (2000940 found)
+find_batch     198 milliseconds (2000940 found)
+
+RobinHoodHashMap:
+put loop       194 milliseconds
+build_from     121 milliseconds
+find loop      425 milliseconds (2000940 found)
+find_batch     178 milliseconds (2000940 found)
+
+ChainHashMap:
+put loop      1420 milliseconds
+build_from     683 milliseconds
+find loop      777 milliseconds (2000940 found)
+find_batch     538 milliseconds (2000940 found)
+
+*/
@@ -0,0 +1,133 @@
+#include <algorithm> // provides std::shuffle
+#include <chrono>
+#include <cstddef>  // provides std::max_align_t
+#include <cstdlib>  // provides EXIT_SUCCESS, std::malloc, std::free
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>   // provides std::stoi
+#include <vector>
+
+#include "chain_hash_map.h"
+#include "inline_chain_hash_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// Counts calls to the global allocator, and the number of bytes currently allocated
+/// (each block records its size in a header)
+static long allocations{0};
+static long live_bytes{0};
+static const size_t HEADER{alignof(max_align_t)};
+
+void* operator new(size_t n) {
+    allocations++;
+    live_bytes += n;
+    if (char* p = static_cast<char*>(malloc(n + HEADER))) {
+        *reinterpret_cast<size_t*>(p) = n;
+        return p + HEADER;
+    }
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept {
+    if (p == nullptr) return;
+    char* block{static_cast<char*>(p) - HEADER};
+    live_bytes -= *reinterpret_cast<size_t*>(block);
+    free(block);
+}
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+/// Inserts n random keys into a map with the given maximum load factor, then looks up
+/// each of them and n absent keys, reporting the times, the heap allocations per insertion,
+/// and the bytes in use per entry.
+template <typename Map>
+void experiment(const string& name, int n, float load) {
+    mt19937 rng(n);
+    vector<int> keys;
+    for (int j = 0; j < n; j++)
+        keys.push_back(rng() & 0x3fffffff);                     // absent keys will have high bit set
+    shuffle(keys.begin(), keys.end(), rng);
+
+    long bytes_before{live_bytes}, allocations_before{allocations};
+    auto start = high_resolution_clock::now();
+    Map* map{new Map()};
+    map->max_load_factor(load);
+    for (int j = 0; j < n; j++)
+        map->put(keys[j], j);
+    auto stop = high_resolution_clock::now();
+    double insert_time = duration_cast<milliseconds>(stop-start).count();
+    double bytes = live_bytes - bytes_before;
+    double allocs = allocations - allocations_before;
+
+    long found{0};
+    start = high_resolution_clock::now();
+    for (int k : keys)
+        if (map->contains(k)) found++;
+    stop = high_resolution_clock::now();
+    double hit_time = duration_cast<milliseconds>(stop-start).count();
+
+    start = high_resolution_clock::now();
+    for (int k : keys)
+        if (map->contains(k | 0x40000000)) found++;
+    stop = high_resolution_clock::now();
+    double miss_time = duration_cast<milliseconds>(stop-start).count();
+    delete map;
+
+    cout << setw(28) << left << name << right << setw(6) << setprecision(2) << fixed << load
+         << setw(10) << setprecision(0) << insert_time << setw(10) << hit_time << setw(10) << miss_time
+         << setw(12) << setprecision(2) << allocs / n << setw(12) << setprecision(1) << bytes / n
+         << (found == n ? "" : "  (wrong count)") << endl;
+}
+
+/// Compares ChainHashMap (a std::list per bucket) with InlineChainHashMap. The command line
+/// arguments set the smallest and largest number of entries (which are doubled in between).
+int main(int argc, char* argv[]) {
+    int smallest{argc >= 2 ? stoi(argv[1]) : 1000000};      // fewest entries (default 1000000)
+    int largest{argc >= 3 ? stoi(argv[2]) : 4000000};       // most entries (default 4000000)
+
+    for (int n = smallest; n <= largest; n *= 2) {
+        cout << endl << n << " entries:" << endl;
+        cout << setw(28) << left << "map" << right << setw(6) << "load" << setw(10) << "insert"
+             << setw(10) << "hit" << setw(10) << "miss" << setw(12) << "allocs/put" << setw(12) << "bytes/entry"
+             << "   (times in milliseconds)" << endl;
+        experiment<ChainHashMap<int,int>>("ChainHashMap", n, 0.5);
+        experiment<ChainHashMap<int,int>>("ChainHashMap", n, 1.0);
+        experiment<InlineChainHashMap<int,int>>("InlineChainHashMap", n, 0.5);
+        experiment<InlineChainHashMap<int,int>>("InlineChainHashMap", n, 1.0);
+        experiment<InlineChainHashMap<int,int,hash<int>,PrimeSizing,1>>("InlineChainHashMap (N=1)", n, 1.0);
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (default arguments; larger sizes behave similarly, as long as the maps fit
+in memory, e.g. ./chain_experiment 25000000 100000000 needs roughly 10 GB):
+
+1000000 entries:
+map                           load    insert       hit      miss  allocs/put bytes/entry   (times in milliseconds)
+ChainHashMap                  0.50       703       179       285        1.00        91.4
+ChainHashMap                  1.00       651       216       375        1.00        57.7
+InlineChainHashMap            0.50       217        90        91        0.00        89.9
+InlineChainHashMap            1.00       116       117       129        0.00        45.1
+InlineChainHashMap (N=1)      1.00       120        93       103        0.00        28.7
+
+2000000 entries:
+map                           load    insert       hit      miss  allocs/put bytes/entry   (times in milliseconds)
+ChainHashMap                  0.50      1474       328       472        1.00        91.4
+ChainHashMap                  1.00      1199       400       590        1.00        57.7
+InlineChainHashMap            0.50       491       242       227        0.00        89.9
+InlineChainHashMap            1.00       315       205       251        0.00        45.1
+InlineChainHashMap (N=1)      1.00       308       274       276        0.00        28.7
+
+4000000 entries:
+map                           load    insert       hit      miss  allocs/put bytes/entry   (times in milliseconds)
+ChainHashMap                  0.50      3304       797      1210        1.00        91.3
+ChainHashMap                  1.00      3060       909      1637        1.00        57.6
+InlineChainHashMap            0.50      1131       610       612        0.00        89.9
+InlineChainHashMap            1.00       754       551       633        0.00        45.1
+InlineChainHashMap (N=1)      1.00       720       528       642        0.00        28.6
+
+*/
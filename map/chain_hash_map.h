@@ -1,58 +1,165 @@
 #pragma once
 
 #include "abstract_hash_map.h"
-#include "unordered_list_map.h"
 
+#include <algorithm>                // defines std::max
 #include <functional>               // defines std::hash
+#include <list>
+#include <memory>                   // defines std::unique_ptr
+#include <stdexcept>
 #include <utility>                  // defines std::pair, std::make_pair
 #include <vector>
 
 namespace dsac::map {
 
-template <typename Key, typename Value, typename Hash = std::hash<Key>>
-class ChainHashMap : public AbstractHashMap<Key, Value, Hash> {
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Sizing = PrimeSizing>
+class ChainHashMap : public AbstractHashMap<Key, Value, Hash, Sizing> {
   protected:
-    typedef AbstractHashMap<Key, Value, Hash> Base;
+    typedef AbstractHashMap<Key, Value, Hash, Sizing> Base;
   public:
     using typename Base::Entry;                                  // make nested Entry public
   protected:
-    using typename Base::abstract_iter_rep, Base::get_rep, Base::table_sz, Base::sz;
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator, Base::table_sz, Base::sz;
     
-    typedef UnorderedListMap<Key,Value>  Bucket;                 // each bucket will be a simple map
+    typedef std::list<Entry> Bucket;                             // each bucket is an unordered list of entries
     typedef typename Bucket::const_iterator BCI;                 // bucket const_iterator
     
-    std::vector<Bucket> table;
+    // An array of buckets stored in separately allocated segments. A new table is created
+    // without constructing any buckets (a segment is allocated when one of its buckets first
+    // receives an entry), and an old table can be released one segment at a time, so that
+    // the cost of allocating and freeing bucket memory is spread over many puts.
+    class BucketTable {
+        static constexpr int SEGMENT{1024};                      // buckets per segment
+        std::vector<std::unique_ptr<Bucket[]>> segments;         // nullptr for a segment of empty buckets
+        int n{0};                                                // number of buckets
+      public:
+        BucketTable() = default;
+        BucketTable(BucketTable&&) = default;
+        BucketTable(const BucketTable& other) : segments(other.segments.size()), n{other.n} {
+            for (int s = 0; s < segments.size(); s++)
+                if (other.segments[s])
+                    segments[s].reset(new Bucket[SEGMENT]);
+            for (int h = 0; h < n; h++)
+                if (!other[h].empty()) (*this)[h] = other[h];
+        }
+        BucketTable& operator=(BucketTable other) { swap(other); return *this; }
+
+        static const Bucket& none() { static const Bucket empty; return empty; }   // any unallocated bucket
+
+        int size() const { return n; }
+        bool empty() const { return n == 0; }
+        void swap(BucketTable& other) { segments.swap(other.segments); std::swap(n, other.n); }
+
+        // discards all buckets, leaving the given number of empty ones (with no segments allocated)
+        void assign(int buckets) {
+            std::vector<std::unique_ptr<Bucket[]>>((buckets + SEGMENT - 1) / SEGMENT).swap(segments);
+            n = buckets;
+        }
+
+        const Bucket& operator[](int h) const {
+            const Bucket* seg{segments[h / SEGMENT].get()};
+            return seg ? seg[h % SEGMENT] : none();
+        }
+
+        Bucket& operator[](int h) {                              // allocates the segment if necessary
+            std::unique_ptr<Bucket[]>& seg{segments[h / SEGMENT]};
+            if (!seg) seg.reset(new Bucket[SEGMENT]);
+            return seg[h % SEGMENT];
+        }
+
+        // releases the segment that ends with bucket h, if h is the last in its segment (all
+        // of whose buckets must be empty)
+        void release_through(int h) {
+            if (h % SEGMENT == SEGMENT - 1 || h == n - 1)
+                segments[h / SEGMENT].reset();
+        }
+
+        // number of bytes allocated for the segments and the array that refers to them
+        std::size_t bytes() const {
+            std::size_t total{segments.capacity() * sizeof(segments[0])};
+            for (const auto& seg : segments)
+                if (seg) total += SEGMENT * sizeof(Bucket);
+            return total;
+        }
+    }; // end class BucketTable
+
+    BucketTable table;
+    BucketTable old_table;                                       // buckets awaiting migration during a rehash
+    int migrated{0};                                             // old buckets [0,migrated) have been emptied
+    int rehash_step{0};                                          // old buckets migrated per put (0 for all at once)
+    int migrate_step{0};                                         // step for the current rehash (at least rehash_step)
     
-    void create_table() {
-        table.clear();
-        table.resize(table_sz);                                  // fills with empty buckets
+    void create_table() { table.assign(table_sz); }             // all buckets are initially empty
+
+    // Buckets are numbered with those of the current table first, followed by those of
+    // the old table (if a rehash is in progress)
+    int num_buckets() const { return table.size() + old_table.size(); }
+    const Bucket& bucket(int b) const { return b < table.size() ? table[b] : old_table[b - table.size()]; }
+    Bucket& bucket(int b) { return b < table.size() ? table[b] : old_table[b - table.size()]; }
+
+    // Moves the entries of up to n old buckets into the current table (relinking list nodes),
+    // releasing each old segment once all of its buckets have been emptied
+    void migrate(int n) {
+        for ( ; n > 0 && migrated < old_table.size(); n--, migrated++) {
+            const Bucket& peek{std::as_const(old_table)[migrated]};    // avoids allocating an empty segment
+            if (!peek.empty()) {
+                Bucket& old{old_table[migrated]};
+                while (!old.empty()) {
+                    int h{this->get_hash(old.front().key())};
+                    table[h].splice(table[h].end(), old, old.begin());
+                }
+            }
+            old_table.release_through(migrated);
+        }
+        if (migrated == old_table.size()) {                      // rehash is complete
+            old_table.assign(0);
+            migrated = 0;
+        }
     }
 
-    class iter_rep : public abstract_iter_rep {                  // specialize abstract version
+    // Begins a rehash into a table of the given size, and completes it unless incremental.
+    // Every put migrates migrate_step old buckets, and only a put that adds an entry brings
+    // the next resize closer, so the step is raised (if necessary) to finish the rehash
+    // within the insertions that the new table can accept before it must grow again.
+    void resize(int new_table_size) {
+        migrate(old_table.size());                               // finish any rehash in progress
+        table.swap(old_table);
+        table_sz = new_table_size;
+        create_table();
+        if (rehash_step == 0)
+            migrate(old_table.size());
+        else {
+            int room{std::max(1, int(this->max_load * table_sz) - sz)};   // insertions before next growth
+            migrate_step = std::max(rehash_step, int((old_table.size() + room - 1) / room));
+        }
+    }
+
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {    // specialize abstract version
       public:
-        const std::vector<Bucket>* tbl{nullptr};                 // need table to advance
-        int bkt_num{0};                                          // which bucket in table?
+        const ChainHashMap* map{nullptr};                        // need map's buckets to advance
+        int bkt_num{0};                                          // which bucket?
         BCI bkt_iter;                                            // which location within that bucket?
-        iter_rep(const std::vector<Bucket>* t, int b, BCI it) : tbl{t}, bkt_num{b}, bkt_iter{it} {}
+        iter_rep(const ChainHashMap* m, int b, BCI it) : map{m}, bkt_num{b}, bkt_iter{it} {}
         
         const Entry& entry() const { return *bkt_iter; }
-        abstract_iter_rep* clone() const { return new iter_rep(*this); }
         
         void advance() {
             ++bkt_iter;                                          // try advancing within current bucket
-            while (bkt_iter == (*tbl)[bkt_num].end()) {
+            while (bkt_iter == map->bucket(bkt_num).end()) {
                 ++bkt_num;                                       // advance one bucket
-                if (bkt_num == tbl->size()) break;               // no buckets left
-                bkt_iter = (*tbl)[bkt_num].begin();              // start at beginning of bucket
+                if (bkt_num == map->num_buckets()) break;        // no buckets left
+                bkt_iter = map->bucket(bkt_num).begin();         // start at beginning of bucket
             }
         }
         
         bool equals(const abstract_iter_rep* other) const {
             const iter_rep* p = dynamic_cast<const iter_rep*>(other);  // cast abstract argument to our iter_rep
             if (p == nullptr) return false;    // failed cast
-            return tbl == p->tbl && bkt_num == p->bkt_num && bkt_iter == p->bkt_iter;
+            return map == p->map && bkt_num == p->bkt_num && bkt_iter == p->bkt_iter;
         }            
     }; // end class iter_rep
+    friend iter_rep;
 
   public:
     using AbstractMap<Key,Value>::erase;                               // makes the key-based version accessible
@@ -60,37 +167,117 @@ class ChainHashMap : public AbstractHashMap<Key, Value, Hash> {
 
     /// Creates an empty map
     ChainHashMap() { create_table(); }                                 // initializes table of buckets
+
+    /// Enables incremental rehashing, in which growing the table moves entries from the given
+    /// number of old buckets during each subsequent put, rather than moving all entries at
+    /// once. A larger step is used when needed so that a rehash always completes before the
+    /// table must grow again (for example, at least 2 with the default maximum load factor).
+    /// A step of 0 restores the default of rehashing all at once.
+    void incremental_rehash(int buckets_per_put) {
+        if (buckets_per_put < 0)
+            throw std::invalid_argument("rehash step must be nonnegative");
+        rehash_step = buckets_per_put;
+        if (rehash_step == 0) migrate(old_table.size());
+    }
+
+    /// Returns true if an incremental rehash is in progress
+    bool rehashing() const { return !old_table.empty(); }
+
+    /// Reports the occupancy of the buckets (including any awaiting migration)
+    HashMapLayout layout() const {
+        HashMapLayout result;
+        result.entries = sz;
+        result.buckets = num_buckets();
+        result.bytes = table.bytes() + old_table.bytes();
+        for (int b = 0; b < num_buckets(); b++) {
+            result.count(bucket(b).size());
+            result.bytes += bucket(b).size() * (sizeof(Entry) + 2 * sizeof(void*));   // list nodes
+        }
+        return result;
+    }
     
     const_iterator begin() const {
-        iter_rep* p = new iter_rep(&table, 0, table[0].begin());
-        if (table[0].empty()) p->advance();                            // advance to first actual entry (or end)
-        return const_iterator(p);
+        iter_rep r(this, 0, table[0].begin());
+        if (table[0].empty()) r.advance();                             // advance to first actual entry (or end)
+        return make_iterator(r);
     }
 
     const_iterator end() const {
-        return const_iterator(new iter_rep(&table, table.size(), table[table.size() - 1].end()));
+        int last{num_buckets() - 1};
+        return make_iterator(iter_rep(this, last + 1, bucket(last).end()));
     }
 
   protected:
+    // returns list iterator to the entry with key k in the given bucket, or the bucket's end,
+    // adding the number of entries examined to probes
+    BCI bucket_search(const Bucket& bkt, const Key& k, int& probes) const {
+        BCI walk{bkt.begin()};
+        for ( ; walk != bkt.end(); ++walk) {
+            probes++;
+            if (walk->key() == k) break;
+        }
+        return walk;
+    }
+
+    // returns the number of the bucket holding key k (known to hash to h in the current
+    // table), or -1 if not found; bkt_iter is set to the entry's location. The entries
+    // examined are added to probes, including those of a bucket awaiting migration.
+    int locate(int h, const Key& k, BCI& bkt_iter, int& probes) const {
+        bkt_iter = bucket_search(table[h], k, probes);
+        int result{-1};
+        if (bkt_iter != table[h].end())
+            result = h;
+        else if (rehashing()) {                                        // perhaps not yet migrated
+            int old_h{Sizing::index(this->hash(k), old_table.size())};
+            if (old_h >= migrated) {
+                bkt_iter = bucket_search(old_table[old_h], k, probes);
+                if (bkt_iter != old_table[old_h].end())
+                    result = table.size() + old_h;
+            }
+        }
+        return result;
+    }
+
+    // prefetches the bucket's list header (its first node is only known once that arrives)
+    void bucket_prefetch(int h) const { prefetch(&table[h]); }
+
     const_iterator bucket_find(int h, const Key& k) const {            // searches for k in bucket h
-        BCI here{table[h].find(k)};
-        if (here != table[h].end())                                    // found it!
-            return const_iterator(new iter_rep(&table, h, here));
+        BCI here;
+        int probes{0};                                                 // entries examined (for statistics)
+        int b{locate(h, k, here, probes)};
+        this->record_probe(probes);                                    // only lookups are recorded
+        if (b >= 0)                                                    // found it!
+            return make_iterator(iter_rep(this, b, here));
         else
             return end();
     }
 
-    const_iterator bucket_put(int h, const Key& k, const Value& v)  {  // calls put(k,v) on bucket h
-        int old_size{table[h].size()};
-        BCI result{table[h].put(k,v)};
-        sz += (table[h].size() - old_size);                            // one more if new key
-        return const_iterator(new iter_rep(&table, h, result));
+    template <typename K, typename V>
+    const_iterator bucket_insert(int h, K&& k, V&& v) {                // copies or moves k and v as given
+        if (rehashing()) migrate(migrate_step);                         // advance a rehash in progress
+        BCI here;
+        int probes{0};
+        int b{locate(h, k, here, probes)};
+        if (b >= 0)
+            this->update_value(*here, std::forward<V>(v));             // overwrite existing value
+        else {
+            table[h].emplace_back(std::forward<K>(k), std::forward<V>(v));    // key is new
+            here = --table[h].end();
+            b = h;
+            sz++;
+        }
+        return make_iterator(iter_rep(this, b, here));
     }
+
+    const_iterator bucket_put(int h, const Key& k, const Value& v) { return bucket_insert(h, k, v); }
+    const_iterator bucket_put(int h, Key&& k, Value&& v) { return bucket_insert(h, std::move(k), std::move(v)); }
     
-    const_iterator bucket_erase(int h, const_iterator loc) {           // calls erase(loc) on bucket h
+    const_iterator bucket_erase(int h, const_iterator loc) {           // calls erase(loc) on loc's bucket
         const_iterator next{loc};
         ++next;                                                        // precompute next location
-        table[h].erase(dynamic_cast<iter_rep*>(get_rep(loc))->bkt_iter);
+        (void)h;                                                       // bucket is known to the iterator
+        iter_rep* rep{dynamic_cast<iter_rep*>(get_rep(loc))};
+        bucket(rep->bkt_num).erase(rep->bkt_iter);
         sz--;
         return next;
     }
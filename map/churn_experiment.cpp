@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <string>   // provides std::stoi
+
+#include "probe_hash_map.h"
+#include "robin_hood_hash_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// Keeps a sliding window of n live keys: each operation inserts a new key and erases
+/// the oldest one. Reports the time for each successive batch of n such operations.
+template <typename Map>
+void experiment(const string& name, int n, int batches) {
+    Map map;
+    for (int j = 0; j < n; j++)
+        map.put(j, j);
+
+    cout << endl << name << ":" << endl;
+    int oldest{0};
+    for (int b = 0; b < batches; b++) {
+        auto start = high_resolution_clock::now();
+        for (int j = 0; j < n; j++) {
+            map.put(oldest + n, oldest);
+            map.erase(oldest++);
+        }
+        auto stop = high_resolution_clock::now();
+        auto elapsed = duration_cast<milliseconds>(stop-start).count();
+        cout << "batch " << setw(3) << b << " took " << setw(9) << elapsed << " milliseconds" << endl;
+    }
+}
+
+/// Compares ProbeHashMap, whose erased cells remain DEFUNCT until the next resize, with
+/// RobinHoodHashMap, which uses backward-shift deletion. The first command line argument
+/// sets the number of live keys, and the second the number of batches of churn.
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 10000};        // live keys (default 10000)
+    int batches{argc >= 3 ? stoi(argv[2]) : 5};      // number of batches (default 5)
+
+    experiment<ProbeHashMap<int,int>>("ProbeHashMap", n, batches);
+    experiment<RobinHoodHashMap<int,int>>("RobinHoodHashMap", n, batches);
+
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (n=10000, 4 batches):
+
+ProbeHashMap:
+batch   0 took         0 milliseconds
+batch   1 took       737 milliseconds
+batch   2 took       851 milliseconds
+batch   3 took       722 milliseconds
+
+RobinHoodHashMap:
+batch   0 took         0 milliseconds
+batch   1 took         0 milliseconds
+batch   2 took         0 milliseconds
+batch   3 took         0 milliseconds
+
+*/
@@ -0,0 +1,78 @@
+#pragma once
+#include <memory>        // defines std::shared_ptr, std::atomic_load, std::atomic_store
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "cost_performance.h"
+
+namespace dsac::map {
+
+// A CostPerformanceDatabase that may be shared by many threads. Queries are answered from
+// an immutable snapshot of the database, obtained without waiting for any lock, so a reader
+// sees either all or none of each batch of additions. Writers build a new version from a
+// copy of the current one and then publish it. Batches that arrive while another writer is
+// busy are combined, so that a burst of small batches costs only one or two copies.
+//
+// The OrderedMap may be OrderedTableMap, BTreeMap, or a balanced TreeMap such as AVLTreeMap
+// or RedBlackTreeMap (but not SplayTreeMap, whose searches modify the tree).
+template <typename OrderedMap = OrderedTableMap<int,int>>
+class ConcurrentCostPerformanceDatabase {
+  public:
+    typedef CostPerformanceDatabase<OrderedMap> Database;
+    typedef std::shared_ptr<const Database> Snapshot;
+
+  private:
+    Snapshot current{std::make_shared<Database>()};      // accessed with atomic_load/atomic_store
+    std::mutex writer;                                    // held while building a new version
+    std::mutex pending_lock;                              // guards pending
+    std::vector<std::pair<int,int>> pending;              // additions not yet applied
+
+  public:
+    // Returns the current version of the database, which will never change; queries on
+    // the same snapshot are therefore consistent with each other
+    Snapshot snapshot() const { return std::atomic_load(&current); }
+
+    // Returns the number of entries in the current version
+    int size() const { return snapshot()->size(); }
+
+    // Returns the (cost,performance) entry with largest cost not exceeding c, if any
+    std::optional<std::pair<int,int>> best(int c) const {
+        Snapshot db{snapshot()};
+        auto it = db->best(c);
+        if (it == db->end())
+            return std::nullopt;
+        return std::make_pair(it->key(), it->value());
+    }
+
+    // Returns the (cost,performance) entries with cost in the range [a, b], in order of cost
+    std::vector<std::pair<int,int>> range(int a, int b) const { return snapshot()->range(a, b); }
+
+    // Adds each (cost,performance) pair in the range [first, last), which become visible to
+    // readers all at once (no later than when this function returns)
+    template <typename InputIt>
+    void add_all(InputIt first, InputIt last) {
+        {
+            std::lock_guard<std::mutex> guard(pending_lock);
+            pending.insert(pending.end(), first, last);
+        }
+        std::lock_guard<std::mutex> guard(writer);
+        std::vector<std::pair<int,int>> batch;
+        {
+            std::lock_guard<std::mutex> guard(pending_lock);
+            batch.swap(pending);
+        }
+        if (batch.empty()) return;                        // another writer already applied ours
+        std::shared_ptr<Database> next{std::make_shared<Database>(*snapshot())};
+        next->add_all(batch.begin(), batch.end());
+        std::atomic_store(&current, Snapshot(next));
+    }
+
+    // Adds a single (cost,performance) pair
+    void add(int c, int p) {
+        std::pair<int,int> one{c, p};
+        add_all(&one, &one + 1);
+    }
+};
+
+} // namespace dsac::map
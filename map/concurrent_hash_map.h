@@ -0,0 +1,144 @@
+#pragma once
+
+#include "chain_hash_map.h"
+#include "table_sizing.h"                 // defines mix_bits
+
+#include <functional>                     // defines std::hash
+#include <mutex>                          // defines std::unique_lock
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace dsac::map {
+
+/// A hash map that may be used by many threads at once. The keys are partitioned
+/// among a fixed number of shards, each an independent single-threaded map guarded
+/// by its own reader-writer lock, so threads only contend when they use the same shard.
+///
+/// Because another thread may modify the map at any time, queries return copies of
+/// values rather than iterators into the map.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Shard = ChainHashMap<Key,Value,Hash>>
+class ConcurrentHashMap {
+  private:
+    struct alignas(64) LockedShard {              // align to avoid false sharing between locks
+        mutable std::shared_mutex lock;
+        Shard map;
+    };
+
+    std::vector<LockedShard> shards;
+    Hash hash;
+
+    // high bits of the mixed hash select a shard, as the shard's own table uses the low bits
+    const LockedShard& shard_for(const Key& k) const {
+        return shards[(mix_bits(hash(k)) >> 32) % shards.size()];
+    }
+    LockedShard& shard_for(const Key& k) {
+        return shards[(mix_bits(hash(k)) >> 32) % shards.size()];
+    }
+
+    typedef std::shared_lock<std::shared_mutex> ReadLock;
+    typedef std::unique_lock<std::shared_mutex> WriteLock;
+
+  public:
+    /// Creates an empty map with the given number of shards
+    explicit ConcurrentHashMap(int num_shards = 64) : shards(num_shards) {
+        if (num_shards <= 0)
+            throw std::invalid_argument("number of shards must be positive");
+    }
+
+    /// Returns the number of shards
+    int num_shards() const { return shards.size(); }
+
+    /// Returns the number of entries (which may be out of date if other threads are active)
+    int size() const {
+        int total{0};
+        for (const LockedShard& s : shards) {
+            ReadLock guard(s.lock);
+            total += s.map.size();
+        }
+        return total;
+    }
+
+    /// Returns true if the map is empty (which may be out of date if other threads are active)
+    bool empty() const { return size() == 0; }
+
+    /// Returns true if the map contains an entry with the given key
+    bool contains(const Key& k) const {
+        const LockedShard& s{shard_for(k)};
+        ReadLock guard(s.lock);
+        return s.map.contains(k);
+    }
+
+    /// Returns a copy of the value associated with the given key, or nothing if not found
+    std::optional<Value> find(const Key& k) const {
+        const LockedShard& s{shard_for(k)};
+        ReadLock guard(s.lock);
+        auto it = s.map.find(k);
+        if (it == s.map.end())
+            return std::nullopt;
+        return it->value();
+    }
+
+    /// Associates given key with given value, overwriting any previous value.
+    /// Returns true if the key was not previously in the map.
+    bool put(const Key& k, const Value& v) {
+        LockedShard& s{shard_for(k)};
+        WriteLock guard(s.lock);
+        return s.map.insert_or_assign(k, v).second;
+    }
+
+    /// Erases the entry with the given key (if one exists).
+    /// Returns true if an entry was removed, false otherwise.
+    bool erase(const Key& k) {
+        LockedShard& s{shard_for(k)};
+        WriteLock guard(s.lock);
+        return s.map.erase(k);
+    }
+
+    /// Returns a copy of the value associated with the given key. If the key is absent, the
+    /// value make(k) is first associated with it, with no other thread able to intervene.
+    template <typename F>
+    Value compute_if_absent(const Key& k, F make) {
+        LockedShard& s{shard_for(k)};
+        WriteLock guard(s.lock);
+        auto it = s.map.find(k);
+        if (it == s.map.end())
+            it = s.map.put(k, make(k));
+        return it->value();
+    }
+
+    /// Associates the key with v if it is absent, and otherwise replaces its existing
+    /// value old with combine(old, v), atomically with respect to other threads
+    template <typename F>
+    void merge(const Key& k, const Value& v, F combine) {
+        LockedShard& s{shard_for(k)};
+        WriteLock guard(s.lock);
+        auto it = s.map.find(k);
+        if (it == s.map.end())
+            s.map.put(k, v);
+        else
+            s.map.put(k, combine(it->value(), v));
+    }
+
+    /// Calls visit(entry) for each entry of the given shard, while holding that shard's
+    /// lock, so the entries visited are a consistent snapshot of that shard
+    template <typename F>
+    void for_each_in_shard(int shard, F visit) const {
+        const LockedShard& s{shards.at(shard)};
+        ReadLock guard(s.lock);
+        for (const auto& entry : s.map)
+            visit(entry);
+    }
+
+    /// Calls visit(entry) for every entry, one shard at a time (each shard is a
+    /// consistent snapshot, but other threads may modify a shard not being visited)
+    template <typename F>
+    void for_each(F visit) const {
+        for (int j = 0; j < shards.size(); j++)
+            for_each_in_shard(j, visit);
+    }
+};
+
+} // namespace dsac::map
@@ -1,7 +1,9 @@
 #pragma once
+#include <algorithm>     // defines std::sort
 #include <list>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 #include "ordered_table_map.h"
 
 namespace dsac::map {
@@ -17,6 +19,9 @@ class CostPerformanceDatabase {
   public:
     const_iterator begin() const { return database.begin(); }
     const_iterator end() const { return database.end(); }
+
+    // Returns the number of (cost,performance) entries, none of which dominates another
+    int size() const { return database.size(); }
     
     // Returns iterator to (cost,performance) entry with largest cost not exceeding c, or end() if no such entry
     const_iterator best(int c) const {
@@ -37,6 +42,31 @@ class CostPerformanceDatabase {
         while (old != end() && old->value() <= p)                         // if not better performance
             old = database.erase(old);                                    // remove the old entry
     }
+
+    // Adds each (cost,performance) pair in the range [first, last). The batch is first sorted
+    // by cost and reduced to the pairs that no other pair of the batch dominates, so that
+    // only those are added to the database.
+    template <typename InputIt>
+    void add_all(InputIt first, InputIt last) {
+        std::vector<std::pair<int,int>> batch(first, last);
+        std::sort(batch.begin(), batch.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first || (a.first == b.first && a.second > b.second);
+        });
+        int best_p{0};
+        for (int j = 0; j < batch.size(); j++)
+            if (j == 0 || batch[j].second > best_p) {                     // not dominated by a cheaper pair
+                add(batch[j].first, batch[j].second);
+                best_p = batch[j].second;
+            }
+    }
+
+    // Returns the (cost,performance) entries with cost in the range [a, b], in order of cost
+    std::vector<std::pair<int,int>> range(int a, int b) const {
+        std::vector<std::pair<int,int>> result;
+        for (const_iterator walk{database.lower_bound(a)}; walk != end() && walk->key() <= b; ++walk)
+            result.push_back({walk->key(), walk->value()});
+        return result;
+    }
 };
 
 } // namespace dsac::map
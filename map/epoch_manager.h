@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>                     // defines std::hash
+#include <stdexcept>
+#include <thread>                         // defines std::this_thread::get_id
+#include <vector>
+
+namespace dsac::map {
+
+/// Epoch-based reclamation, allowing readers to traverse a linked structure without
+/// locks while a writer unlinks and later deletes its nodes.
+///
+/// A reader pins the current epoch for the duration of its traversal. A writer retires
+/// each unlinked object with the epoch in which it was unlinked, and an object is only
+/// deleted once every pinned reader began in a later epoch, at which point no reader can
+/// still hold a pointer to it. Retiring and reclaiming must be done by one thread at a
+/// time (e.g., by writers holding a common lock); any number of threads may pin.
+///
+/// Each pinned reader normally has a slot of its own. When all MAX_READERS slots are taken,
+/// further readers share one overflow slot, which pins the oldest epoch of any reader in
+/// it, so pinning never waits for another reader. While the overflow slot stays occupied
+/// its epoch cannot advance, which may delay reclamation but never makes it unsafe.
+class EpochManager {
+  private:
+    static constexpr int MAX_READERS{128};          // readers with slots of their own
+    static constexpr int COUNT_BITS{20};            // bits for the number of readers sharing overflow
+    static constexpr std::uint64_t COUNT_MASK{(std::uint64_t(1) << COUNT_BITS) - 1};
+    static constexpr int SHARED{-1};                // slot number of a reader in the overflow slot
+
+    struct alignas(64) Slot {                       // one cache line per slot
+        std::atomic<std::uint64_t> epoch{0};        // pinned epoch, or 0 if slot is free
+    };
+
+    // The overflow slot packs the epoch it pins (in the high bits) with the number of
+    // readers sharing it (in the low COUNT_BITS bits); the epoch is ignored when no reader
+    // is present
+    struct alignas(64) SharedSlot {
+        std::atomic<std::uint64_t> state{0};
+    };
+
+    struct Retired {
+        std::uint64_t epoch;
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    Slot slots[MAX_READERS];
+    SharedSlot overflow;
+    std::atomic<std::uint64_t> global{1};
+    std::vector<Retired> retired;
+
+    template <typename T>
+    static void destroy(void* p) { delete static_cast<T*>(p); }
+
+    // each thread starts its search for a free slot at a position determined by its id
+    static int home_slot() {
+        thread_local int home = std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS;
+        return home;
+    }
+
+    // claims a free slot, recording the current epoch within it; if every slot is taken,
+    // joins the overflow slot instead (and returns SHARED)
+    int pin() {
+        for (int n = 0, j = home_slot(); n < MAX_READERS; n++, j = (j + 1) % MAX_READERS) {
+            std::uint64_t free{0};
+            if (slots[j].epoch.load(std::memory_order_relaxed) == 0 &&
+                slots[j].epoch.compare_exchange_strong(free, global.load()))
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);  // pairs with fence in reclaim
+                return j;
+            }
+        }
+        std::uint64_t state{overflow.state.load()};
+        std::uint64_t joined;
+        do {                                        // the first reader in sets the epoch; others share it
+            std::uint64_t count{state & COUNT_MASK};
+            if (count == COUNT_MASK)
+                throw std::runtime_error("too many readers pinned at once");
+            std::uint64_t epoch{count == 0 ? global.load() : state >> COUNT_BITS};
+            joined = (epoch << COUNT_BITS) | (count + 1);
+        } while (!overflow.state.compare_exchange_weak(state, joined));
+        std::atomic_thread_fence(std::memory_order_seq_cst);          // pairs with fence in reclaim
+        return SHARED;
+    }
+
+    void unpin(int j) {
+        if (j == SHARED)
+            overflow.state.fetch_sub(1, std::memory_order_release);   // leaves the epoch in place
+        else
+            slots[j].epoch.store(0, std::memory_order_release);
+    }
+
+  public:
+    /// Pins the current epoch for as long as the guard exists
+    class Guard {
+        friend EpochManager;
+      private:
+        EpochManager* manager;
+        int slot;
+        Guard(EpochManager* m) : manager{m}, slot{m->pin()} {}
+      public:
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() { manager->unpin(slot); }
+    };
+
+    EpochManager() {}
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    /// Deletes all retired objects (no reader may be pinned)
+    ~EpochManager() {
+        for (Retired& r : retired)
+            r.destroy(r.object);
+    }
+
+    /// Pins the current epoch, protecting everything reachable at this moment. Throws
+    /// runtime_error in the unlikely event that over a million readers are pinned at once.
+    Guard guard() { return Guard(this); }
+
+    /// Schedules deletion of an object that has been unlinked from the shared structure
+    template <typename T>
+    void retire(T* object) {
+        retired.push_back({global.fetch_add(1), object, &destroy<T>});
+    }
+
+    /// Returns the number of retired objects not yet deleted
+    int pending() const { return retired.size(); }
+
+    /// Deletes each retired object that no pinned reader can still reach
+    void reclaim() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);              // pairs with fence in pin
+        std::uint64_t oldest{UINT64_MAX};
+        for (const Slot& s : slots) {
+            std::uint64_t e{s.epoch.load()};
+            if (e != 0 && e < oldest) oldest = e;
+        }
+        std::uint64_t shared{overflow.state.load()};
+        if ((shared & COUNT_MASK) != 0 && (shared >> COUNT_BITS) < oldest)
+            oldest = shared >> COUNT_BITS;
+        int kept{0};
+        for (Retired& r : retired)
+            if (r.epoch < oldest)
+                r.destroy(r.object);
+            else
+                retired[kept++] = r;
+        retired.resize(kept);
+    }
+};
+
+} // namespace dsac::map
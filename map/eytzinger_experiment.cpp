@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <vector>
+
+#include "eytzinger_map.h"
+#include "ordered_table_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// Performs lower_bound for each query, reporting the time per search
+template <typename Map>
+void searches(const string& name, const Map& map, const vector<int>& queries) {
+    long total{0};
+    auto start = high_resolution_clock::now();
+    for (int q : queries) {
+        auto it = map.lower_bound(q);
+        if (it != map.end()) total += it->value();
+    }
+    auto stop = high_resolution_clock::now();
+    double elapsed = duration_cast<nanoseconds>(stop-start).count();
+    cout << setw(17) << name << ": " << setw(7) << fixed << setprecision(1)
+         << elapsed / queries.size() << " nanoseconds per lower_bound (checksum " << total << ")" << endl;
+}
+
+/// Builds an OrderedTableMap of n entries with random even keys, and an EytzingerMap with
+/// the same entries, then compares lower_bound for the given number of random queries
+void experiment(int n, int m) {
+    mt19937 rng(n);
+    OrderedTableMap<int,int> sorted;
+    for (int j = 0; j < n; j++)
+        sorted.put(2 * j, j);                                    // keys in increasing order
+    auto start = high_resolution_clock::now();
+    EytzingerMap<int,int> eytzinger(sorted);
+    auto stop = high_resolution_clock::now();
+    vector<int> queries;
+    for (int j = 0; j < m; j++)
+        queries.push_back(rng() % (2 * n));
+
+    cout << endl << n << " entries (EytzingerMap built in "
+         << duration_cast<milliseconds>(stop-start).count() << " milliseconds):" << endl;
+    searches("OrderedTableMap", sorted, queries);
+    searches("EytzingerMap", eytzinger, queries);
+}
+
+/// The command line arguments set the smallest and largest number of entries (which are
+/// multiplied by 10 in between) and the number of queries for each size.
+int main(int argc, char* argv[]) {
+    int smallest{argc >= 2 ? stoi(argv[1]) : 1000};          // fewest entries (default 1000)
+    int largest{argc >= 3 ? stoi(argv[2]) : 10000000};       // most entries (default 10000000)
+    int m{argc >= 4 ? stoi(argv[3]) : 2000000};              // number of queries (default 2000000)
+
+    for (int n = smallest; n <= largest; n *= 10)
+        experiment(n, m);
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (default arguments):
+
+1000 entries (EytzingerMap built in 0 milliseconds):
+  OrderedTableMap:   126.1 nanoseconds per lower_bound (checksum 998845755)
+     EytzingerMap:    44.1 nanoseconds per lower_bound (checksum 998845755)
+
+10000 entries (EytzingerMap built in 0 milliseconds):
+  OrderedTableMap:   150.8 nanoseconds per lower_bound (checksum 10002870882)
+     EytzingerMap:    65.7 nanoseconds per lower_bound (checksum 10002870882)
+
+100000 entries (EytzingerMap built in 4 milliseconds):
+  OrderedTableMap:   208.5 nanoseconds per lower_bound (checksum 99992459220)
+     EytzingerMap:    86.6 nanoseconds per lower_bound (checksum 99992459220)
+
+1000000 entries (EytzingerMap built in 54 milliseconds):
+  OrderedTableMap:   336.1 nanoseconds per lower_bound (checksum 1000700263978)
+     EytzingerMap:   226.1 nanoseconds per lower_bound (checksum 1000700263978)
+
+10000000 entries (EytzingerMap built in 471 milliseconds):
+  OrderedTableMap:   630.4 nanoseconds per lower_bound (checksum 9996731182330)
+     EytzingerMap:   342.4 nanoseconds per lower_bound (checksum 9996731182330)
+
+*/
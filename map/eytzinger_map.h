@@ -0,0 +1,165 @@
+#pragma once
+
+#include "abstract_hash_map.h"            // defines prefetch
+#include "abstract_map.h"
+
+#include <algorithm>                      // defines std::sort
+#include <functional>                     // defines std::less
+#include <stdexcept>
+#include <utility>                        // defines std::move
+#include <vector>
+
+namespace dsac::map {
+
+/// A read-only sorted map, built from the entries of another map, that is designed for
+/// fast searches of large tables. Entries are stored in Eytzinger (breadth-first) order:
+/// the entry at index k has children at 2k and 2k+1, like a binary heap, and the keys are
+/// also copied to an array of their own, so a search touches only keys. A binary search
+/// then reads indices 1, 2 or 3, 4 through 7, and so on, so the first levels share a few
+/// cache lines, and the 16 possible nodes four levels down are adjacent and can be
+/// prefetched well before they are needed. Each step descends without a branch, so the
+/// processor never mispredicts the direction of the search. The map supports the same
+/// find, lower_bound, and upper_bound operations as OrderedTableMap, and iterates in key
+/// order; to change it, build a new one.
+template <typename Key, typename Value, typename Compare=std::less<Key>>
+class EytzingerMap : public AbstractMap<Key,Value> {
+  protected:
+    typedef AbstractMap<Key,Value> Base;
+  public:
+    using typename Base::Entry;
+    using typename Base::const_iterator;
+    using Base::erase;
+  protected:
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator;
+
+    std::vector<Key> keys;                           // keys[k] for 1 <= k <= n in Eytzinger order
+    std::vector<Entry> table;                        // table[k] is the entry with key keys[k]
+    Compare less_than;
+
+    // Moves the entries of sorted[i], sorted[i+1], ... to the nodes of the subtree rooted
+    // at index k, in order. Returns the index of the first entry not yet placed.
+    int place(std::vector<Entry>& sorted, int i, int k) {
+        if (k < table.size()) {
+            i = place(sorted, i, 2 * k);
+            keys[k] = sorted[i].key();
+            table[k] = std::move(sorted[i]);
+            i = place(sorted, i + 1, 2 * k + 1);
+        }
+        return i;
+    }
+
+    // Returns the index of the first node whose key does not satisfy go_right (which must
+    // hold for a prefix of the keys in order), or 0 if all keys satisfy it
+    template <typename GoRight>
+    int search(GoRight go_right) const {
+        int k{1};
+        while (k < keys.size()) {
+            if (16 * k < keys.size())
+                prefetch(&keys[16 * k]);             // the descendants four levels down
+            k = 2 * k + go_right(keys[k]);
+        }
+        return k >> __builtin_ffs(~k);               // undo right turns, and the last left turn
+    }
+
+    int lower_bound_index(const Key& target) const {
+        return search([&](const Key& k) { return less_than(k, target); });
+    }
+
+    int upper_bound_index(const Key& target) const {
+        return search([&](const Key& k) { return !less_than(target, k); });
+    }
+
+    // index of the first node in order within the subtree rooted at k (or 0 if empty)
+    int leftmost(int k) const {
+        while (2 * k < table.size()) k = 2 * k;
+        return (k < table.size() ? k : 0);
+    }
+
+    // index of the last node in order within the subtree rooted at k (or 0 if empty)
+    int rightmost(int k) const {
+        while (2 * k + 1 < table.size()) k = 2 * k + 1;
+        return (k < table.size() ? k : 0);
+    }
+
+    // A position is the index of a node, with 0 representing the end. Iteration walks
+    // the implicit tree in order, as for a linked binary tree.
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {     // specialize abstract version
+      public:
+        const EytzingerMap* map;
+        int k;
+        iter_rep(const EytzingerMap* m, int k) : map{m}, k{k} {}
+
+        const Entry& entry() const { return map->table[k]; }
+        void advance() {
+            if (2 * k + 1 < map->table.size())
+                k = map->leftmost(2 * k + 1);                  // first node of right subtree
+            else {
+                while (k & 1) k >>= 1;                         // climb while a right child
+                k >>= 1;                                       // then once more (0 past the root)
+            }
+        }
+        void retreat() {
+            if (k == 0)
+                k = map->rightmost(1);                         // from end to last node
+            else if (2 * k < map->table.size())
+                k = map->rightmost(2 * k);                     // last node of left subtree
+            else {
+                while (k > 1 && !(k & 1)) k >>= 1;             // climb while a left child
+                k >>= 1;
+            }
+        }
+        bool equals(const abstract_iter_rep* other) const {
+            const iter_rep* p = dynamic_cast<const iter_rep*>(other);
+            return p != nullptr && map == p->map && k == p->k;
+        }
+    };  //------- end of class iter_rep --------
+    friend iter_rep;
+
+  public:
+    /// Builds a map with the same entries as the given map (which may be of any type)
+    explicit EytzingerMap(const AbstractMap<Key,Value>& source) {
+        std::vector<Entry> sorted;
+        sorted.reserve(source.size());
+        for (const Entry& e : source)
+            sorted.push_back(e);
+        std::sort(sorted.begin(), sorted.end(),
+                  [&](const Entry& a, const Entry& b) { return less_than(a.key(), b.key()); });
+        keys.resize(sorted.size() + 1);
+        table.resize(sorted.size() + 1);                       // index 0 is unused
+        place(sorted, 0, 1);
+    }
+
+    /// Returns the number of entries in the map
+    int size() const { return table.size() - 1; }
+
+    /// Returns a const_iterator to first entry
+    const_iterator begin() const { return make_iterator(iter_rep(this, leftmost(1))); }
+
+    /// Returns a const_iterator representing the end
+    const_iterator end() const { return make_iterator(iter_rep(this, 0)); }
+
+    /// Returns a const_iterator to the entry with a given key, or end() if no such entry exists
+    const_iterator find(const Key& k) const {
+        int j{lower_bound_index(k)};
+        if (j != 0 && !less_than(k, keys[j]))                             // exact match
+            return make_iterator(iter_rep(this, j));
+        else
+            return end();
+    }
+
+    /// Returns a const_iterator to the first entry with key greater than or equal to k, or end() if no such entry exists
+    const_iterator lower_bound(const Key& k) const { return make_iterator(iter_rep(this, lower_bound_index(k))); }
+
+    /// Returns a const_iterator to the first entry with key strictly greater than k, or end() if no such entry exists
+    const_iterator upper_bound(const Key& k) const { return make_iterator(iter_rep(this, upper_bound_index(k))); }
+
+    /// The map is read-only, so put throws logic_error
+    const_iterator put(const Key&, const Value&) { throw std::logic_error("EytzingerMap is read-only"); }
+    const_iterator put(Key&&, Value&&) { throw std::logic_error("EytzingerMap is read-only"); }
+
+    /// The map is read-only, so erase throws logic_error
+    const_iterator erase(const_iterator) { throw std::logic_error("EytzingerMap is read-only"); }
+};
+
+} // namespace dsac::map
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>                      // defines std::lower_bound, std::stable_sort
+#include <cstddef>                        // defines std::size_t
+#include <functional>                     // defines std::less
+#include <map>
+#include <utility>                        // defines std::pair, std::move
+#include <vector>
+
+namespace dsac::map {
+
+/// A read-only view of consecutive values stored within a multimap
+template <typename Value>
+class ValueSpan {
+  private:
+    const Value* first{nullptr};
+    const Value* last{nullptr};
+  public:
+    ValueSpan() {}
+    ValueSpan(const Value* first, const Value* last) : first{first}, last{last} {}
+    const Value* begin() const { return first; }
+    const Value* end() const { return last; }
+    std::size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    const Value& operator[](std::size_t j) const { return first[j]; }
+};
+
+/// A multimap that stores each distinct key once, with all of its values in one vector
+/// (in order of insertion). Compared with OurMultimap, which keeps a list node holding a
+/// copy of the key for every value, this uses far less memory when keys have many values,
+/// and equal_range returns the values of a key as one contiguous span.
+template <typename Key, typename Value, typename Compare=std::less<Key>>
+class FlatMultimap {
+  private:
+    typedef std::map<Key, std::vector<Value>, Compare> Primary;
+
+    Primary primary;                                     // initially empty
+    std::size_t sz{0};
+
+  public:
+    typedef typename Primary::const_iterator const_iterator;   // refers to a (key, values) pair
+
+    /// Returns the number of (key, value) pairs
+    std::size_t size() const { return sz; }
+
+    /// Returns true if the multimap is empty
+    bool empty() const { return sz == 0; }
+
+    /// Returns the number of distinct keys
+    std::size_t key_count() const { return primary.size(); }
+
+    /// Returns the number of values associated with key k
+    std::size_t count(const Key& k) const {
+        auto pi = primary.find(k);
+        return (pi == primary.end() ? 0 : pi->second.size());
+    }
+
+    /// Returns the values associated with key k (an empty span if there are none), which
+    /// remain valid until the next change to that key's values
+    ValueSpan<Value> equal_range(const Key& k) const {
+        auto pi = primary.find(k);
+        if (pi == primary.end())
+            return ValueSpan<Value>();
+        return ValueSpan<Value>(pi->second.data(), pi->second.data() + pi->second.size());
+    }
+
+    /// Iterates over distinct keys in order, each paired with the vector of its values
+    const_iterator begin() const { return primary.begin(); }
+    const_iterator end() const { return primary.end(); }
+
+    /// Associates value v with key k
+    void insert(const Key& k, const Value& v) {
+        primary[k].push_back(v);
+        sz++;
+    }
+
+    /// Same as above, with the key and value given as a pair
+    void insert(const std::pair<const Key,Value>& e) { insert(e.first, e.second); }
+
+    /// Associates each value in the range [first, last) with key k, finding the key once
+    template <typename InputIt>
+    void insert(const Key& k, InputIt first, InputIt last) {
+        if (first == last) return;                           // a key is never left without values
+        std::vector<Value>& values{primary[k]};
+        std::size_t before{values.size()};
+        values.insert(values.end(), first, last);
+        sz += values.size() - before;
+    }
+
+    /// Adds each (key, value) pair in the range [first, last). Pairs are grouped by key
+    /// (stably, so each key's values keep their order), so that each distinct key is
+    /// searched for once and its vector grows at most once.
+    template <typename InputIt>
+    void insert_all(InputIt first, InputIt last) {
+        std::vector<std::pair<Key,Value>> items(first, last);
+        Compare less_than;
+        std::stable_sort(items.begin(), items.end(),
+                         [&](const auto& a, const auto& b) { return less_than(a.first, b.first); });
+        auto hint = primary.begin();
+        for (std::size_t j = 0, run; j < items.size(); j += run) {
+            for (run = 1; j + run < items.size() && !less_than(items[j].first, items[j + run].first); run++) { }
+            hint = primary.try_emplace(hint, items[j].first);
+            hint->second.reserve(hint->second.size() + run);
+            for (std::size_t r = j; r < j + run; r++)
+                hint->second.push_back(std::move(items[r].second));
+            sz += run;
+        }
+    }
+
+    /// Removes all values associated with key k, returning the number removed
+    std::size_t erase(const Key& k) {
+        auto pi = primary.find(k);
+        if (pi == primary.end())
+            return 0;
+        std::size_t removed{pi->second.size()};
+        sz -= removed;
+        primary.erase(pi);
+        return removed;
+    }
+};
+
+/// An immutable multimap in compressed sparse row form: one sorted array of the distinct
+/// keys, one array of all values grouped by key, and an array of offsets such that the
+/// values of keys[j] occupy positions offsets[j] through offsets[j+1]-1. There is no
+/// per-key or per-value allocation, and a key's values are found by binary search.
+template <typename Key, typename Value, typename Compare=std::less<Key>>
+class FrozenMultimap {
+  private:
+    std::vector<Key> keys;
+    std::vector<std::size_t> offsets{0};                 // offsets.size() is keys.size()+1
+    std::vector<Value> values;
+    Compare less_than;
+
+    // index of key k within keys, or keys.size() if absent
+    std::size_t index(const Key& k) const {
+        auto it = std::lower_bound(keys.begin(), keys.end(), k, less_than);
+        return (it != keys.end() && !less_than(k, *it) ? it - keys.begin() : keys.size());
+    }
+
+  public:
+    /// Creates an empty multimap
+    FrozenMultimap() {}
+
+    /// Creates a multimap with the same contents as the given FlatMultimap
+    explicit FrozenMultimap(const FlatMultimap<Key,Value,Compare>& source) {
+        keys.reserve(source.key_count());
+        offsets.reserve(source.key_count() + 1);
+        values.reserve(source.size());
+        for (const auto& [k, vals] : source) {
+            keys.push_back(k);
+            values.insert(values.end(), vals.begin(), vals.end());
+            offsets.push_back(values.size());
+        }
+    }
+
+    /// Creates a multimap with the (key, value) pairs in the range [first, last); the
+    /// values of each key keep their relative order
+    template <typename InputIt>
+    FrozenMultimap(InputIt first, InputIt last) {
+        std::vector<std::pair<Key,Value>> items(first, last);
+        std::stable_sort(items.begin(), items.end(),
+                         [&](const auto& a, const auto& b) { return less_than(a.first, b.first); });
+        values.reserve(items.size());
+        for (std::size_t j = 0; j < items.size(); j++) {
+            if (j == 0 || less_than(keys.back(), items[j].first)) {
+                if (j > 0) offsets.push_back(values.size());
+                keys.push_back(items[j].first);
+            }
+            values.push_back(std::move(items[j].second));
+        }
+        if (!keys.empty()) offsets.push_back(values.size());
+    }
+
+    /// Returns the number of (key, value) pairs
+    std::size_t size() const { return values.size(); }
+
+    /// Returns true if the multimap is empty
+    bool empty() const { return values.empty(); }
+
+    /// Returns the number of distinct keys
+    std::size_t key_count() const { return keys.size(); }
+
+    /// Returns the number of values associated with key k
+    std::size_t count(const Key& k) const { return equal_range(k).size(); }
+
+    /// Returns the values associated with key k (an empty span if there are none)
+    ValueSpan<Value> equal_range(const Key& k) const {
+        std::size_t j{index(k)};
+        if (j == keys.size())
+            return ValueSpan<Value>();
+        return ValueSpan<Value>(values.data() + offsets[j], values.data() + offsets[j + 1]);
+    }
+
+    /// Calls visit(key, values) for each distinct key in order, where values is a ValueSpan
+    template <typename F>
+    void for_each(F visit) const {
+        for (std::size_t j = 0; j < keys.size(); j++)
+            visit(keys[j], ValueSpan<Value>(values.data() + offsets[j], values.data() + offsets[j + 1]));
+    }
+};
+
+} // namespace dsac::map
@@ -1,10 +1,13 @@
 #include "hash_code.h"
+#include <cstdint>
+#include <cstring>                                    // defines std::memcpy
 #include <limits>
-#include <string>
+#include <random>                                     // defines std::random_device
+#include <string_view>
 
 namespace dsac::map {
 
-int hash_code(std::string s) {
+int hash_code(std::string_view s) {
     const int U_INT_BITS{std::numeric_limits<unsigned int>::digits};
     int h{0};
     for (char c : s) {
@@ -14,4 +17,90 @@ int hash_code(std::string s) {
     return (h < 0 ? -h : h);                          // return absolute value
 }
 
+namespace {
+
+// constants from wyhash
+const std::uint64_t P0{0xa0761d6478bd642fULL}, P1{0xe7037ed1a0b428dbULL}, P2{0x8ebc6af09c88c6e3ULL};
+
+// computes the 128-bit product of a and b as its low and high 64-bit halves
+void multiply(std::uint64_t a, std::uint64_t b, std::uint64_t& lo, std::uint64_t& hi) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    uint128 r{static_cast<uint128>(a) * b};
+    lo = static_cast<std::uint64_t>(r);
+    hi = static_cast<std::uint64_t>(r >> 64);
+#else
+    std::uint64_t ha{a >> 32}, la{a & 0xffffffff}, hb{b >> 32}, lb{b & 0xffffffff};
+    std::uint64_t rh{ha * hb}, rm0{ha * lb}, rm1{hb * la}, rl{la * lb};
+    std::uint64_t t{rl + (rm0 << 32)};
+    lo = t + (rm1 << 32);
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+#endif
+}
+
+// multiplies a and b, and folds the two halves of the product together with xor
+std::uint64_t mum(std::uint64_t a, std::uint64_t b) {
+    std::uint64_t lo, hi;
+    multiply(a, b, lo, hi);
+    return lo ^ hi;
+}
+
+// unaligned little-endian reads (memcpy compiles to a single load)
+std::uint64_t read8(const char* p) { std::uint64_t v; std::memcpy(&v, p, 8); return v; }
+std::uint64_t read4(const char* p) { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+// reads 1 to 3 bytes, using the first, middle, and last
+std::uint64_t read_small(const char* p, std::size_t n) {
+    return (std::uint64_t(std::uint8_t(p[0])) << 16) | (std::uint64_t(std::uint8_t(p[n >> 1])) << 8)
+           | std::uint8_t(p[n - 1]);
+}
+
+} // namespace
+
+std::uint64_t fast_hash(std::string_view s, std::uint64_t seed) {
+    const char* p{s.data()};
+    std::size_t n{s.size()};
+    seed ^= mum(seed ^ P0, P1);
+    std::uint64_t a, b;
+    if (n <= 16) {
+        if (n >= 4) {                                 // two (possibly overlapping) 8- or 4-byte pairs
+            std::size_t shift{(n >> 3) << 2};
+            a = (read4(p) << 32) | read4(p + shift);
+            b = (read4(p + n - 4) << 32) | read4(p + n - 4 - shift);
+        } else if (n > 0) {
+            a = read_small(p, n);
+            b = 0;
+        } else
+            a = b = 0;
+    } else {
+        std::size_t i{n};
+        if (i > 48) {                                 // three independent lanes of 16 bytes
+            std::uint64_t see1{seed}, see2{seed};
+            do {
+                seed = mum(read8(p) ^ P1, read8(p + 8) ^ seed);
+                see1 = mum(read8(p + 16) ^ P2, read8(p + 24) ^ see1);
+                see2 = mum(read8(p + 32) ^ P0, read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mum(read8(p) ^ P1, read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = read8(p + i - 16);                        // final 16 bytes (overlapping if needed)
+        b = read8(p + i - 8);
+    }
+    std::uint64_t lo, hi;
+    multiply(a ^ P1, b ^ seed, lo, hi);
+    return mum(lo ^ P0 ^ n, hi ^ P1);
+}
+
+std::uint64_t random_seed() {
+    std::random_device rd;
+    return (std::uint64_t(rd()) << 32) ^ rd();
+}
+
 } // namespace dsac::map
@@ -1,8 +1,31 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace dsac::map {
 
-int hash_code(std::string s);
-    
+/// Polynomial-style hash code using a 5-bit cyclic shift per character
+int hash_code(std::string_view s);
+
+/// A fast 64-bit hash in the style of wyhash, consuming 16 bytes per step and mixing
+/// each step with a 64x64->128-bit multiplication. Different seeds give unrelated hashes.
+std::uint64_t fast_hash(std::string_view s, std::uint64_t seed = 0);
+
+/// Returns a seed drawn from std::random_device
+std::uint64_t random_seed();
+
+/// Hash functor for strings using fast_hash with a seed chosen at random when the functor
+/// is created. Since each hash map holds its own functor, every map gets its own seed,
+/// so an adversary cannot precompute keys that all collide (a "HashDoS" attack).
+class SeededStringHash {
+  private:
+    std::uint64_t seed;
+  public:
+    SeededStringHash() : seed{random_seed()} {}
+    explicit SeededStringHash(std::uint64_t seed) : seed{seed} {}
+    std::size_t operator()(std::string_view s) const { return fast_hash(s, seed); }
+};
+
 } // namespace dsac::map
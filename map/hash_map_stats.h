@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>      // defines std::min
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace dsac::map {
+
+/// Statistics that a hash map records as it operates, when the program is compiled with
+/// -DDSAC_MAP_STATS. Otherwise the class is empty and each recording function does nothing,
+/// so that the instrumentation compiles away entirely. Probe lengths are recorded only for
+/// lookups (each call of find, including those made by contains, at, erase and upsert, and
+/// by put when a full table must check whether the key is new), not for the search that put
+/// makes to store the entry. Lookups may be recorded by several threads at once (as when
+/// readers share a lock), so the probe counts are atomic.
+class HashMapStats {
+#ifdef DSAC_MAP_STATS
+  public:
+    static constexpr bool enabled{true};
+    static constexpr int MAX_PROBE{64};       // longer lookups are counted with this length
+
+    /// probes[j] is the number of lookups that examined exactly j cells (or chained entries),
+    /// except that probes[MAX_PROBE] counts those that examined MAX_PROBE or more
+    mutable std::atomic<long> probes[MAX_PROBE + 1]{};
+    long resizes{0};                           // number of times the table was resized
+    double resize_seconds{0};                  // total time spent resizing
+
+    HashMapStats() {}
+    HashMapStats(const HashMapStats& other) { *this = other; }
+    HashMapStats& operator=(const HashMapStats& other) {
+        for (int j = 0; j <= MAX_PROBE; j++)
+            probes[j].store(other.probes[j].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        resizes = other.resizes;
+        resize_seconds = other.resize_seconds;
+        return *this;
+    }
+
+    void record_probe(int length) const {
+        probes[std::min(length, MAX_PROBE)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Measures the time until it is destroyed as one resize
+    class ResizeTimer {
+        HashMapStats* stats;
+        std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+      public:
+        explicit ResizeTimer(HashMapStats* s) : stats{s} {}
+        ResizeTimer(const ResizeTimer&) = delete;
+        ~ResizeTimer() {
+            std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+            stats->resizes++;
+            stats->resize_seconds += elapsed.count();
+        }
+    };
+    ResizeTimer time_resize() { return ResizeTimer(this); }
+
+    /// Returns the average number of cells examined per lookup
+    double average_probe() const {
+        long lookups{0}, total{0};
+        for (int j = 0; j <= MAX_PROBE; j++) {
+            long count{probes[j].load(std::memory_order_relaxed)};
+            lookups += count;
+            total += j * count;
+        }
+        return lookups == 0 ? 0 : double(total) / lookups;
+    }
+#else
+  public:
+    static constexpr bool enabled{false};
+
+    void record_probe(int) const {}
+
+    struct ResizeTimer { ~ResizeTimer() {} };
+    ResizeTimer time_resize() { return ResizeTimer(); }
+#endif
+};
+
+/// A snapshot of how a hash map's table is occupied, as reported by its layout() function
+struct HashMapLayout {
+    int entries{0};
+    int buckets{0};                            // number of buckets (or cells, for open addressing)
+    int defunct{0};                            // cells marked as deleted (open addressing only)
+    std::size_t bytes{0};                      // memory used by the table and any nodes
+
+    /// With chaining, histogram[j] is the number of buckets holding j entries. With open
+    /// addressing, histogram[j] is the number of clusters (maximal runs of nonempty cells,
+    /// including defunct cells) of length j.
+    std::vector<long> histogram;
+
+    void count(int j) {
+        if (j >= histogram.size()) histogram.resize(j + 1);
+        histogram[j]++;
+    }
+};
+
+/// Prints a readable summary of the statistics and layout of a hash map
+inline void dump(std::ostream& out, const HashMapStats& stats, const HashMapLayout& layout) {
+    out << "entries: " << layout.entries << ", buckets: " << layout.buckets
+        << ", load factor: " << double(layout.entries) / layout.buckets << std::endl;
+    if (layout.defunct > 0)
+        out << "defunct cells: " << layout.defunct
+            << " (" << 100.0 * layout.defunct / layout.buckets << "% of table)" << std::endl;
+    out << "bytes used: " << layout.bytes
+        << " (" << double(layout.bytes) / (layout.entries > 0 ? layout.entries : 1) << " per entry)" << std::endl;
+    out << "occupancy histogram:";
+    for (int j = 0; j < layout.histogram.size(); j++)
+        if (layout.histogram[j] > 0) out << " " << j << ":" << layout.histogram[j];
+    out << std::endl;
+#ifdef DSAC_MAP_STATS
+    out << "resizes: " << stats.resizes << " taking " << 1000 * stats.resize_seconds << " milliseconds" << std::endl;
+    out << "probe lengths (average " << stats.average_probe() << "):";
+    for (int j = 0; j <= HashMapStats::MAX_PROBE; j++)
+        if (long count{stats.probes[j].load()}; count > 0)
+            out << " " << j << (j == HashMapStats::MAX_PROBE ? "+:" : ":") << count;
+    out << std::endl;
+#else
+    (void)stats;
+    out << "(compile with -DDSAC_MAP_STATS for probe lengths and resize counts)" << std::endl;
+#endif
+}
+
+} // namespace dsac::map
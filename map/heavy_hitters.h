@@ -0,0 +1,220 @@
+#pragma once
+
+#include "abstract_map.h"
+#include "robin_hood_hash_map.h"
+#include "table_sizing.h"                 // defines mix_bits
+#include "priority/heap_adaptable_priority_queue.h"
+#include "priority/heap_priority_queue.h"
+
+#include <algorithm>                      // defines std::sort, std::min, std::max
+#include <cmath>                          // defines std::ceil, std::exp
+#include <cstdint>
+#include <functional>                     // defines std::hash
+#include <stdexcept>
+#include <utility>                        // defines std::pair
+#include <vector>
+
+namespace dsac::map {
+
+/// A key with its (possibly estimated) number of occurrences
+template <typename Key>
+struct HeavyHitter {
+    Key key;
+    long count;                           // never less than the true number of occurrences
+    long error;                           // count exceeds the true number by at most error
+};
+
+// Returns up to k hitters from the given (count, key) pairs, most frequent first
+template <typename Key>
+std::vector<HeavyHitter<Key>> most_frequent(std::vector<HeavyHitter<Key>> all, int k) {
+    std::sort(all.begin(), all.end(), [](const HeavyHitter<Key>& a, const HeavyHitter<Key>& b) {
+        return a.count > b.count || (a.count == b.count && a.key < b.key);
+    });
+    if (all.size() > k)
+        all.resize(std::max(k, 0));
+    return all;
+}
+
+/// Returns the k entries of freq with the largest values, most frequent first. A min-heap
+/// holds the k largest values seen so far, so that each other entry need only be compared
+/// with the heap's minimum; this takes O(n log k) time and O(k) extra space for n entries.
+template <typename Key, typename Value>
+std::vector<HeavyHitter<Key>> top_k(const AbstractMap<Key,Value>& freq, int k) {
+    dsac::priority::HeapPriorityQueue<std::pair<Value,Key>> heap;          // (count, key) pairs
+    for (const auto& entry : freq) {
+        if (heap.size() < k)
+            heap.insert({entry.value(), entry.key()});
+        else if (k > 0 && heap.min() < std::make_pair(entry.value(), entry.key())) {
+            heap.remove_min();
+            heap.insert({entry.value(), entry.key()});
+        }
+    }
+    std::vector<HeavyHitter<Key>> result(heap.size());
+    for (int j = heap.size() - 1; j >= 0; j--) {                          // least frequent last
+        result[j] = {heap.min().second, long(heap.min().first), 0};
+        heap.remove_min();
+    }
+    return result;
+}
+
+/// The Space-Saving algorithm of Metwally, Agrawal, and El Abbadi, which finds the most
+/// frequent keys of a stream using a fixed number of counters, however many distinct keys
+/// there are. When a key without a counter arrives and all counters are in use, the
+/// counter with the smallest count is reassigned to it (keeping that count, plus one, as
+/// an overestimate). Any key that occurs more than n/capacity times in a stream of length
+/// n is certain to have a counter, and no count exceeds the truth by more than n/capacity.
+/// The counters are kept in a RobinHoodHashMap, since a map of fixed size with constant
+/// erasures would otherwise fill with DEFUNCT cells that slow every unsuccessful search.
+template <typename Key, typename Hash = std::hash<Key>>
+class SpaceSaving {
+  private:
+    typedef dsac::priority::HeapAdaptablePriorityQueue<std::pair<long,Key>> Heap;  // (count, key) pairs
+    struct Counter {
+        typename Heap::Locator where{nullptr};                             // position within heap
+        long count{0};
+        long error{0};
+    };
+
+    int capacity;
+    Heap heap;                                                             // least count at root
+    RobinHoodHashMap<Key,Counter,Hash> counters;
+
+  public:
+    /// Creates an empty summary with the given number of counters
+    explicit SpaceSaving(int capacity) : capacity{capacity} {
+        if (capacity <= 0)
+            throw std::invalid_argument("capacity must be positive");
+    }
+
+    /// Records one occurrence of key k
+    void add(const Key& k) {
+        int before{counters.size()};
+        counters.upsert(k, Counter(), [&](Counter& c) {                    // increment existing counter
+            c.count++;
+            heap.update(c.where, {c.count, k});
+        });
+        if (counters.size() == before) return;
+        Counter c;                                                         // k is new, so assign a counter
+        if (before < capacity)
+            c = {heap.insert({1, k}), 1, 0};
+        else {                                                             // take over least counter
+            Key victim{heap.min().second};
+            c = counters.at(victim);
+            counters.erase(victim);
+            c.error = c.count;
+            c.count++;
+            heap.update(c.where, {c.count, k});
+        }
+        counters.put(k, c);
+    }
+
+    /// Returns the (up to) k keys with the largest counts, most frequent first
+    std::vector<HeavyHitter<Key>> top(int k) const {
+        std::vector<HeavyHitter<Key>> all;
+        for (const auto& entry : counters)
+            all.push_back({entry.key(), entry.value().count, entry.value().error});
+        return most_frequent(all, k);
+    }
+};
+
+/// A Count-Min sketch of Cormode and Muthukrishnan, which estimates the number of
+/// occurrences of each key in a stream using a fixed table of depth rows of width counters.
+/// Each key increments one counter in each row, and its estimate is the least of those
+/// counters, which is never too small. This version uses conservative update (raising
+/// only the counters that equal the minimum), which reduces the overestimates further.
+template <typename Key, typename Hash = std::hash<Key>>
+class CountMinSketch {
+  private:
+    int width;
+    int depth;
+    long total{0};                                       // number of occurrences added
+    std::vector<std::uint32_t> cells;                    // row r occupies [r*width, (r+1)*width)
+    Hash hash;
+
+    // Index of key's counter within row r. The rows use independent-looking functions
+    // g1 + r*g2, derived from the two halves of a single mixed hash code.
+    int cell(std::uint64_t h, int r) const {
+        std::uint64_t g{(h & 0xffffffff) + r * ((h >> 32) | 1)};
+        return r * width + int(((g & 0xffffffff) * width) >> 32);
+    }
+
+  public:
+    /// Creates a sketch with the given number of counters per row and number of rows
+    CountMinSketch(int width, int depth = 4) : width{width}, depth{depth}, cells(std::size_t(width) * depth) {
+        if (width <= 0 || depth <= 0)
+            throw std::invalid_argument("width and depth must be positive");
+    }
+
+    /// Records one occurrence of key k, and returns its new estimated count
+    long add(const Key& k) {
+        std::uint64_t h{mix_bits(hash(k))};
+        std::uint32_t least{UINT32_MAX};
+        for (int r = 0; r < depth; r++)
+            least = std::min(least, cells[cell(h, r)]);
+        for (int r = 0; r < depth; r++)
+            cells[cell(h, r)] = std::max(cells[cell(h, r)], least + 1);
+        total++;
+        return least + 1;
+    }
+
+    /// Returns the estimated number of occurrences of key k (never an underestimate)
+    long estimate(const Key& k) const {
+        std::uint64_t h{mix_bits(hash(k))};
+        std::uint32_t least{UINT32_MAX};
+        for (int r = 0; r < depth; r++)
+            least = std::min(least, cells[cell(h, r)]);
+        return least;
+    }
+
+    /// Returns the amount by which an estimate exceeds the truth, with probability at
+    /// least 1 - exp(-depth): e/width times the number of occurrences added
+    long error_bound() const { return std::ceil(std::exp(1.0) * total / width); }
+};
+
+/// Tracks the k most frequent keys of a stream according to a Count-Min sketch. The
+/// candidates are held in a min-heap of size k: when a key's estimate exceeds that of
+/// the least frequent candidate, it takes that candidate's place.
+template <typename Key, typename Hash = std::hash<Key>>
+class CountMinTopK {
+  private:
+    typedef dsac::priority::HeapAdaptablePriorityQueue<std::pair<long,Key>> Heap;  // (estimate, key) pairs
+
+    int k;
+    CountMinSketch<Key,Hash> sketch;
+    Heap heap;
+    RobinHoodHashMap<Key,typename Heap::Locator,Hash> candidates;    // (see SpaceSaving)
+
+  public:
+    /// Creates a tracker for k keys using a sketch of the given width and depth
+    CountMinTopK(int k, int width, int depth = 4) : k{k}, sketch(width, depth) {
+        if (k <= 0)
+            throw std::invalid_argument("k must be positive");
+    }
+
+    /// Records one occurrence of key k
+    void add(const Key& key) {
+        long estimate{sketch.add(key)};
+        auto it = candidates.find(key);
+        if (it != candidates.end())
+            heap.update(it->value(), {estimate, key});
+        else if (candidates.size() < k)
+            candidates.put(key, heap.insert({estimate, key}));
+        else if (estimate > heap.min().first) {                            // replace least candidate
+            Key victim{heap.min().second};
+            typename Heap::Locator where{candidates.at(victim)};
+            candidates.erase(victim);
+            heap.update(where, {estimate, key});
+            candidates.put(key, where);
+        }
+    }
+
+    /// Returns the candidates with their estimated counts, most frequent first
+    std::vector<HeavyHitter<Key>> top() const {
+        std::vector<HeavyHitter<Key>> all;
+        for (const auto& entry : candidates)
+            all.push_back({entry.key(), sketch.estimate(entry.key()), sketch.error_bound()});
+        return most_frequent(all, k);
+    }
+};
+
+} // namespace dsac::map
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "abstract_hash_map.h"
+
+#include <functional>               // defines std::hash
+#include <utility>                  // defines std::move, std::forward
+#include <vector>
+
+namespace dsac::map {
+
+/// A separate-chaining hash map whose buckets store their first N entries inline, within a
+/// contiguous table, so that most lookups touch a single bucket and most insertions need no
+/// allocation. Entries beyond the first N of a bucket are chained through overflow nodes
+/// that are kept in one shared arena, with erased nodes recycled through a free list.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Sizing = PrimeSizing,
+          int N = 3>
+class InlineChainHashMap : public AbstractHashMap<Key, Value, Hash, Sizing> {
+    static_assert(N >= 1, "buckets must hold at least one entry inline");
+  protected:
+    typedef AbstractHashMap<Key, Value, Hash, Sizing> Base;
+  public:
+    using typename Base::Entry;                                  // make nested Entry public
+  protected:
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator, Base::table_sz, Base::sz;
+
+    struct Bucket {
+        Entry items[N];                                          // items[0..used) are entries
+        int used{0};
+        int overflow{-1};                                        // first overflow node (-1 if none)
+    };
+
+    struct Node {
+        Entry entry;
+        int next;                                                // next node in chain (-1 if none)
+    };
+
+    std::vector<Bucket> table;
+    std::vector<Node> arena;                                     // overflow nodes of all buckets
+    int free_list{-1};                                           // first unused node in arena
+
+    void create_table() {
+        table.clear();
+        table.resize(table_sz);
+        arena.clear();
+        free_list = -1;
+    }
+
+    // Returns the index of an unused arena node, holding entry e
+    int new_node(Entry&& e, int next) {
+        if (free_list < 0) {
+            arena.push_back(Node{std::move(e), next});
+            return arena.size() - 1;
+        }
+        int n{free_list};
+        free_list = arena[n].next;
+        arena[n] = Node{std::move(e), next};
+        return n;
+    }
+
+    void free_node(int n) {
+        arena[n].entry = Entry();                                // release the old key and value
+        arena[n].next = free_list;
+        free_list = n;
+    }
+
+    // Within a bucket, positions 0 to N-1 are inline items, and N+i is arena node i
+    Entry& entry_at(int b, int pos) { return pos < N ? table[b].items[pos] : arena[pos - N].entry; }
+    const Entry& entry_at(int b, int pos) const { return pos < N ? table[b].items[pos] : arena[pos - N].entry; }
+
+    // Returns the position following pos within bucket b, or -1 if pos is the last
+    int next_pos(int b, int pos) const {
+        if (pos < N) {
+            if (pos + 1 < table[b].used) return pos + 1;
+            return (table[b].overflow < 0 ? -1 : N + table[b].overflow);
+        }
+        int next{arena[pos - N].next};
+        return (next < 0 ? -1 : N + next);
+    }
+
+    // Returns the position of key k within bucket h, or -1 if not found, adding the number
+    // of entries examined to probes
+    int bucket_search(int h, const Key& k, int& probes) const {
+        const Bucket& bkt{table[h]};
+        for (int j = 0; j < bkt.used; j++) {
+            probes++;
+            if (bkt.items[j].key() == k)
+                return j;
+        }
+        for (int n = bkt.overflow; n >= 0; n = arena[n].next) {
+            probes++;
+            if (arena[n].entry.key() == k)
+                return N + n;
+        }
+        return -1;
+    }
+
+    // Adds e (whose key is known to be absent) to bucket h, returning its position
+    int place(int h, Entry&& e) {
+        Bucket& bkt{table[h]};
+        if (bkt.used < N) {
+            bkt.items[bkt.used] = std::move(e);
+            return bkt.used++;
+        }
+        bkt.overflow = new_node(std::move(e), bkt.overflow);    // new node heads the chain
+        return N + bkt.overflow;
+    }
+
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {    // specialize abstract version
+      public:
+        const InlineChainHashMap* map{nullptr};
+        int bkt;                                                 // which bucket? (table.size() is end)
+        int pos;                                                 // which position within bucket?
+        iter_rep(const InlineChainHashMap* m, int b, int p) : map{m}, bkt{b}, pos{p} {}
+
+        const Entry& entry() const { return map->entry_at(bkt, pos); }
+
+        void advance() {
+            pos = (bkt < 0 ? -1 : map->next_pos(bkt, pos));
+            skip_empty();
+        }
+
+        // if pos is -1, moves to the first entry of the next nonempty bucket (or to end)
+        void skip_empty() {
+            while (pos < 0 && ++bkt < map->table.size())
+                pos = (map->table[bkt].used > 0 ? 0 : -1);
+            if (pos < 0) pos = 0;                                // end position
+        }
+
+        bool equals(const abstract_iter_rep* other) const {
+            const iter_rep* p = dynamic_cast<const iter_rep*>(other);
+            return p != nullptr && map == p->map && bkt == p->bkt && pos == p->pos;
+        }
+    }; // end class iter_rep
+    friend iter_rep;
+
+  public:
+    using AbstractMap<Key,Value>::erase;                         // makes the Key-based version accessible
+    using typename AbstractMap<Key,Value>::const_iterator;
+
+    /// Creates an empty map
+    InlineChainHashMap() { create_table(); }
+
+    const_iterator begin() const {
+        iter_rep r(this, -1, 0);                                 // artificial bucket -1 before advance
+        r.advance();
+        return make_iterator(r);
+    }
+
+    const_iterator end() const {
+        return make_iterator(iter_rep(this, table.size(), 0));
+    }
+
+    /// Reports the occupancy of the buckets
+    HashMapLayout layout() const {
+        HashMapLayout result;
+        result.entries = sz;
+        result.buckets = table_sz;
+        result.bytes = table.capacity() * sizeof(Bucket) + arena.capacity() * sizeof(Node);
+        for (int b = 0; b < table.size(); b++) {
+            int count{table[b].used};
+            for (int n = table[b].overflow; n >= 0; n = arena[n].next)
+                count++;
+            result.count(count);
+        }
+        return result;
+    }
+
+  protected:
+    void bucket_prefetch(int h) const { prefetch(&table[h]); }
+
+    // search for entry with key k in bucket h
+    const_iterator bucket_find(int h, const Key& k) const {
+        int probes{0};                                           // entries examined (for statistics)
+        int pos{bucket_search(h, k, probes)};
+        this->record_probe(probes);                              // only lookups are recorded
+        return (pos < 0 ? end() : make_iterator(iter_rep(this, h, pos)));
+    }
+
+    // add/update Entry(k,v) within bucket h, copying or moving k and v as given
+    template <typename K, typename V>
+    const_iterator bucket_insert(int h, K&& k, V&& v) {
+        int probes{0};
+        int pos{bucket_search(h, k, probes)};
+        if (pos >= 0)
+            this->update_value(entry_at(h, pos), std::forward<V>(v));   // replace existing value
+        else {
+            pos = place(h, Entry(std::forward<K>(k), std::forward<V>(v)));
+            sz++;
+        }
+        return make_iterator(iter_rep(this, h, pos));
+    }
+
+    const_iterator bucket_put(int h, const Key& k, const Value& v) { return bucket_insert(h, k, v); }
+    const_iterator bucket_put(int h, Key&& k, Value&& v) { return bucket_insert(h, std::move(k), std::move(v)); }
+
+    // Removes the entry at loc. An inline hole is filled by an entry that follows it in
+    // iteration order (the first overflow entry, or else the last inline entry), so that
+    // the returned iterator can refer to the same position; a node is simply unlinked.
+    const_iterator bucket_erase(int h, const_iterator loc) {
+        (void)h;
+        iter_rep r{*dynamic_cast<iter_rep*>(get_rep(loc))};
+        Bucket& bkt{table[r.bkt]};
+        if (r.pos < N) {
+            if (bkt.overflow >= 0) {                             // refill from the chain
+                int n{bkt.overflow};
+                bkt.items[r.pos] = std::move(arena[n].entry);
+                bkt.overflow = arena[n].next;
+                free_node(n);
+            } else {
+                bkt.used--;
+                if (r.pos < bkt.used)                            // refill with last inline entry
+                    bkt.items[r.pos] = std::move(bkt.items[bkt.used]);
+                bkt.items[bkt.used] = Entry();                   // release the old key and value
+                if (r.pos == bkt.used) {                         // erased the bucket's last entry
+                    r.pos = -1;
+                    r.skip_empty();
+                }
+            }
+        } else {
+            int n{r.pos - N};
+            int next{arena[n].next};
+            if (bkt.overflow == n)
+                bkt.overflow = next;
+            else {
+                int prev{bkt.overflow};
+                while (arena[prev].next != n) prev = arena[prev].next;
+                arena[prev].next = next;
+            }
+            free_node(n);
+            r.pos = (next >= 0 ? N + next : -1);
+            r.skip_empty();
+        }
+        sz--;
+        return make_iterator(r);
+    }
+
+    // Change table size, moving each entry directly into its new bucket
+    void resize(int new_table_size) {
+        std::vector<Bucket> old_table;
+        std::vector<Node> old_arena;
+        old_table.swap(table);
+        old_arena.swap(arena);
+        table_sz = new_table_size;
+        create_table();
+        arena.reserve(old_arena.size());
+        for (Bucket& bkt : old_table) {
+            for (int j = 0; j < bkt.used; j++)
+                place(this->get_hash(bkt.items[j].key()), std::move(bkt.items[j]));
+            for (int n = bkt.overflow; n >= 0; n = old_arena[n].next)
+                place(this->get_hash(old_arena[n].entry.key()), std::move(old_arena[n].entry));
+        }
+    }
+};
+
+} // namespace dsac::map
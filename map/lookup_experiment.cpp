@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS, std::malloc, std::free
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>   // provides std::stoi
+
+#include "probe_hash_map.h"
+#include "chain_hash_map.h"
+#include "swiss_hash_map.h"
+#include "ordered_table_map.h"
+#include "searchtree/avl_tree_map.h"
+
+using namespace std;
+using namespace std::chrono;
+
+/// Counts every call to the global allocator made by this program
+static long allocations{0};
+
+void* operator new(size_t n) {
+    allocations++;
+    if (void* p = malloc(n)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/// Fills the map with keys 0, 2, 4, ..., 2(n-1) and then performs 'rounds' passes of n
+/// successful and n unsuccessful contains() queries, reporting the time and number
+/// of heap allocations made per lookup.
+template <typename Map>
+void experiment(const string& name, int n, int rounds) {
+    Map map;
+    for (int j = 0; j < n; j++)
+        map.put(2*j, j);
+
+    long before{allocations};
+    long found{0};
+    auto start = high_resolution_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (int k = 0; k < 2*n; k++)
+            if (map.contains(k)) found++;
+    auto stop = high_resolution_clock::now();
+    long lookups{2L * n * rounds};
+    double elapsed = duration_cast<microseconds>(stop-start).count() / 1000.0;
+
+    cout << setw(18) << name << ": found " << setw(9) << found << " of " << setw(9) << lookups
+         << " in " << setw(9) << fixed << setprecision(1) << elapsed << " milliseconds, "
+         << setprecision(2) << double(allocations - before) / lookups << " allocations per lookup" << endl;
+}
+
+/// Compares lookup costs for the map implementations. The first command line argument
+/// sets the number of entries and the second sets the number of query rounds.
+/// Compile with -DDSAC_ITER_REP_CAPACITY=0 to measure the heap-allocated iterator design.
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 100000};      // number of entries (default 100000)
+    int rounds{argc >= 3 ? stoi(argv[2]) : 10};     // number of query rounds (default 10)
+
+    cout << "iterator representations reserve " << DSAC_ITER_REP_CAPACITY << " bytes" << endl;
+    experiment<dsac::map::ProbeHashMap<int,int>>("ProbeHashMap", n, rounds);
+    experiment<dsac::map::ProbeHashMap<int,int,hash<int>,dsac::map::PowerOfTwoSizing>>("ProbeHashMap/pow2", n, rounds);
+    experiment<dsac::map::ProbeHashMap<int,int,hash<int>,dsac::map::FastRangeSizing>>("ProbeHashMap/fast", n, rounds);
+    experiment<dsac::map::ChainHashMap<int,int>>("ChainHashMap", n, rounds);
+    experiment<dsac::map::SwissHashMap<int,int>>("SwissHashMap", n, rounds);
+    experiment<dsac::map::OrderedTableMap<int,int>>("OrderedTableMap", n, rounds);
+    experiment<dsac::search_tree::AVLTreeMap<int,int>>("AVLTreeMap", n, rounds);
+
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (lookup_experiment and lookup_experiment_heap, with n=100000 and 5 rounds):
+
+iterator representations reserve 32 bytes
+      ProbeHashMap: found    500000 of   1000000 in      26.6 milliseconds, 0.00 allocations per lookup
+ ProbeHashMap/pow2: found    500000 of   1000000 in      47.7 milliseconds, 0.00 allocations per lookup
+ ProbeHashMap/fast: found    500000 of   1000000 in      37.7 milliseconds, 0.00 allocations per lookup
+      ChainHashMap: found    500000 of   1000000 in      23.8 milliseconds, 0.00 allocations per lookup
+      SwissHashMap: found    500000 of   1000000 in      27.2 milliseconds, 0.00 allocations per lookup
+   OrderedTableMap: found    500000 of   1000000 in     102.6 milliseconds, 0.00 allocations per lookup
+        AVLTreeMap: found    500000 of   1000000 in      79.8 milliseconds, 0.00 allocations per lookup
+
+iterator representations reserve 0 bytes
+      ProbeHashMap: found    500000 of   1000000 in      40.7 milliseconds, 2.00 allocations per lookup
+ ProbeHashMap/pow2: found    500000 of   1000000 in      55.6 milliseconds, 2.00 allocations per lookup
+ ProbeHashMap/fast: found    500000 of   1000000 in      65.4 milliseconds, 2.00 allocations per lookup
+      ChainHashMap: found    500000 of   1000000 in      41.6 milliseconds, 2.00 allocations per lookup
+      SwissHashMap: found    500000 of   1000000 in      50.9 milliseconds, 2.00 allocations per lookup
+   OrderedTableMap: found    500000 of   1000000 in     125.2 milliseconds, 2.00 allocations per lookup
+        AVLTreeMap: found    500000 of   1000000 in     129.4 milliseconds, 2.00 allocations per lookup
+
+*/
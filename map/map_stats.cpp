@@ -0,0 +1,52 @@
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iostream>
+#include <string>   // provides std::stod
+#include <vector>
+
+#include "chain_hash_map.h"
+#include "inline_chain_hash_map.h"
+#include "probe_hash_map.h"
+#include "robin_hood_hash_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// Counts the given words in a map, erases the given fraction of the distinct words,
+/// looks up every word once more, and then dumps the map's statistics.
+template <typename Map>
+void report(const string& name, const vector<string>& words, double erase_fraction) {
+    Map freq;
+    for (const string& w : words) {
+        auto it = freq.find(w);
+        freq.put(w, it == freq.end() ? 1 : it->value() + 1);
+    }
+    vector<string> distinct;
+    for (auto entry : freq)
+        distinct.push_back(entry.key());
+    for (int j = 0; j < erase_fraction * distinct.size(); j++)
+        freq.erase(distinct[j]);
+    long found{0};
+    for (const string& w : words)
+        if (freq.contains(w)) found++;
+
+    cout << endl << name << " (" << found << " of " << words.size() << " words found after erasures):" << endl;
+    dump(cout, freq.stats(), freq.layout());
+}
+
+/// Reads words from standard input and reports how each hash map implementation stores
+/// and searches for them. The optional command line argument is the fraction of distinct
+/// words to erase (default 0.25). Compile with -DDSAC_MAP_STATS to include probe lengths.
+int main(int argc, char* argv[]) {
+    double erase_fraction{argc >= 2 ? stod(argv[1]) : 0.25};
+    vector<string> words;
+    string word;
+    while (cin >> word)
+        words.push_back(word);
+
+    report<ProbeHashMap<string,int>>("ProbeHashMap", words, erase_fraction);
+    report<RobinHoodHashMap<string,int>>("RobinHoodHashMap", words, erase_fraction);
+    report<ChainHashMap<string,int>>("ChainHashMap", words, erase_fraction);
+    report<InlineChainHashMap<string,int>>("InlineChainHashMap", words, erase_fraction);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "abstract_map.h"
+#include "hash_code.h"                    // defines fast_hash (link with hash_code.o)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>                        // defines std::memcmp, std::memcpy
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>                    // defines std::is_trivially_copyable
+#include <vector>
+
+#include <fcntl.h>                        // POSIX open
+#include <sys/mman.h>                     // POSIX mmap, munmap
+#include <sys/stat.h>                     // POSIX fstat
+#include <unistd.h>                       // POSIX close
+
+namespace dsac::map {
+
+// A mapped hash map file holds a header, then a table of slots (linear probing over a
+// power-of-two number of slots), then a pool with the characters of all keys. Slots refer
+// to their keys by offset within the pool, so the file is valid wherever it is mapped.
+// Numbers are stored in the byte order of the machine that wrote the file.
+
+struct MappedHeader {
+    char magic[8];                        // "DSACMHM1"
+    std::uint64_t value_size;             // sizeof(Value), as a sanity check
+    std::uint64_t entries;
+    std::uint64_t slots;                  // number of slots (a power of two)
+    std::uint64_t seed;                   // seed for fast_hash
+    std::uint64_t slots_offset;           // byte offset of the slot table within the file
+    std::uint64_t pool_offset;            // byte offset of the key pool within the file
+    std::uint64_t pool_size;
+};
+
+template <typename Value>
+struct MappedSlot {
+    std::uint64_t key_offset;             // offset of key within the pool
+    std::uint32_t key_length;
+    std::uint32_t tag;                    // high bits of key's hash, with low bit set (0 if empty)
+    Value value;
+};
+
+inline constexpr char MAPPED_MAGIC[8]{'D', 'S', 'A', 'C', 'M', 'H', 'M', '1'};
+
+// tag stored within a slot for a key with hash value h (never 0)
+inline std::uint32_t mapped_tag(std::uint64_t h) { return static_cast<std::uint32_t>(h >> 32) | 1; }
+
+// rounds n up to a multiple of a
+inline std::uint64_t mapped_align(std::uint64_t n, std::uint64_t a) { return (n + a - 1) / a * a; }
+
+/// Writes the entries of a map with string keys to the given file, in the format read by
+/// MappedHashMap. The Value type must be trivially copyable (e.g., a number), since values
+/// are stored as raw bytes. Throws runtime_error if the file cannot be written.
+template <typename Key, typename Value>
+void write_mapped_hash_map(const AbstractMap<Key,Value>& map, const std::string& path,
+                           std::uint64_t seed = 0) {
+    static_assert(std::is_trivially_copyable<Value>::value, "values must be trivially copyable");
+    typedef MappedSlot<Value> Slot;
+
+    std::uint64_t num_slots{1};
+    while (2 * num_slots < 3 * std::uint64_t(map.size() + 1))     // keep load factor below 2/3
+        num_slots *= 2;
+    std::vector<Slot> slots(num_slots);
+    std::memset(static_cast<void*>(slots.data()), 0, num_slots * sizeof(Slot));   // also clears padding
+    std::string pool;
+    for (const auto& entry : map) {
+        std::string_view key{entry.key()};
+        std::uint64_t h{fast_hash(key, seed)};
+        std::uint64_t j{h & (num_slots - 1)};
+        while (slots[j].tag != 0)                                  // ends, as a third of slots stay empty
+            j = (j + 1) & (num_slots - 1);
+        slots[j].key_offset = pool.size();
+        slots[j].key_length = key.size();
+        slots[j].tag = mapped_tag(h);
+        slots[j].value = entry.value();
+        pool.append(key);
+    }
+
+    MappedHeader header;
+    std::memcpy(header.magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC));
+    header.value_size = sizeof(Value);
+    header.entries = map.size();
+    header.slots = num_slots;
+    header.seed = seed;
+    header.slots_offset = mapped_align(sizeof(MappedHeader), alignof(Slot));
+    header.pool_offset = header.slots_offset + num_slots * sizeof(Slot);
+    header.pool_size = pool.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("cannot open " + path + " for writing");
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(std::string(header.slots_offset - sizeof(header), '\0').data(), header.slots_offset - sizeof(header));
+    out.write(reinterpret_cast<const char*>(slots.data()), num_slots * sizeof(Slot));
+    out.write(pool.data(), pool.size());
+    out.close();
+    if (!out)
+        throw std::runtime_error("error writing " + path);
+}
+
+/// A read-only hash map with string keys, answered directly from a file written by
+/// write_mapped_hash_map. The file is memory-mapped rather than read, so opening it takes
+/// constant time and pages are loaded by the operating system as lookups touch them.
+template <typename Value>
+class MappedHashMap {
+    static_assert(std::is_trivially_copyable<Value>::value, "values must be trivially copyable");
+  private:
+    typedef MappedSlot<Value> Slot;
+
+    const char* base{nullptr};            // start of mapped file
+    std::size_t length{0};                // length of mapped file
+    const MappedHeader* header{nullptr};
+    const Slot* slots{nullptr};
+    const char* pool{nullptr};
+
+    // checks that the header describes a file of this length with these value types
+    void validate(const std::string& path) const {
+        auto fail = [&](const std::string& why) { throw std::runtime_error(path + ": " + why); };
+        if (length < sizeof(MappedHeader) || std::memcmp(header->magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC)) != 0)
+            fail("not a mapped hash map file");
+        if (header->value_size != sizeof(Value))
+            fail("value size does not match");
+        if (header->slots == 0 || (header->slots & (header->slots - 1)) != 0 || header->entries >= header->slots)
+            fail("corrupt slot count");
+        if (header->slots_offset % alignof(Slot) != 0 || header->slots_offset < sizeof(MappedHeader) ||
+            header->slots_offset > length || header->slots > (length - header->slots_offset) / sizeof(Slot) ||
+            header->pool_offset != header->slots_offset + header->slots * sizeof(Slot) ||
+            header->pool_size > length - header->pool_offset)
+            fail("file is truncated or corrupt");
+    }
+
+    // Returns the key of a nonempty slot. Keys are checked as they are used, rather than
+    // all at once, so that opening the file need not touch every page.
+    std::string_view key(const Slot& s) const {
+        if (s.key_offset > header->pool_size || s.key_length > header->pool_size - s.key_offset)
+            throw std::runtime_error("corrupt mapped hash map: key outside of string pool");
+        return std::string_view(pool + s.key_offset, s.key_length);
+    }
+
+    void release() {
+        if (base != nullptr)
+            munmap(const_cast<char*>(base), length);
+        base = nullptr;
+    }
+
+  public:
+    /// Maps the given file, throwing runtime_error if it cannot be opened or is not valid
+    /// (validation checks the header in constant time; keys are checked as they are read)
+    explicit MappedHashMap(const std::string& path) {
+        int fd{open(path.c_str(), O_RDONLY)};
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            throw std::runtime_error(path + ": not a mapped hash map file");
+        }
+        length = info.st_size;
+        void* p{mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0)};
+        close(fd);                                                  // mapping remains valid
+        if (p == MAP_FAILED)
+            throw std::runtime_error("cannot map " + path);
+        base = static_cast<const char*>(p);
+        header = reinterpret_cast<const MappedHeader*>(base);
+        try {
+            if (length >= sizeof(MappedHeader)) {
+                slots = reinterpret_cast<const Slot*>(base + header->slots_offset);
+                pool = base + header->pool_offset;
+            }
+            validate(path);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    MappedHashMap(const MappedHashMap&) = delete;
+    MappedHashMap& operator=(const MappedHashMap&) = delete;
+
+    ~MappedHashMap() { release(); }
+
+    /// Returns the number of entries in the map
+    int size() const { return header->entries; }
+
+    /// Returns true if the map is empty, false otherwise
+    bool empty() const { return size() == 0; }
+
+    /// Returns a pointer to the value (within the mapped file) associated with the given key,
+    /// or nullptr if the key is not present. A search examines each slot at most once, so it
+    /// ends even if a corrupt file has no empty slot.
+    const Value* find(std::string_view k) const {
+        std::uint64_t h{fast_hash(k, header->seed)};
+        std::uint32_t tag{mapped_tag(h)};
+        std::uint64_t mask{header->slots - 1};
+        std::uint64_t j{h & mask};
+        for (std::uint64_t probes = 0; probes < header->slots && slots[j].tag != 0; probes++, j = (j + 1) & mask)
+            if (slots[j].tag == tag && key(slots[j]) == k)
+                return &slots[j].value;
+        return nullptr;
+    }
+
+    /// Returns true if the map contains an entry with the given key
+    bool contains(std::string_view k) const { return find(k) != nullptr; }
+
+    /// Returns a reference to the value associated with given key,
+    /// or throws out_of_range exception if key not found
+    const Value& at(std::string_view k) const {
+        const Value* v{find(k)};
+        if (v == nullptr)
+            throw std::out_of_range("key not found");
+        return *v;
+    }
+
+    /// Calls visit(key, value) for each entry, with the key as a string_view into the file
+    template <typename F>
+    void for_each(F visit) const {
+        for (std::uint64_t j = 0; j < header->slots; j++)
+            if (slots[j].tag != 0)
+                visit(key(slots[j]), slots[j].value);
+    }
+};
+
+} // namespace dsac::map
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cmath>    // provides std::pow
+#include <cstdlib>  // provides EXIT_SUCCESS, std::malloc, std::free
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>   // provides std::stoi
+#include <utility>
+#include <vector>
+
+#include "flat_multimap.h"
+#include "our_multimap.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// Counts every call to the global allocator made by this program
+static long allocations{0};
+
+void* operator new(size_t n) {
+    allocations++;
+    if (void* p = malloc(n)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/// Reports the time and allocations since the given starting point
+void report(const char* name, high_resolution_clock::time_point start, long before, long postings) {
+    auto stop = high_resolution_clock::now();
+    cout << setw(28) << left << name << right << setw(7) << duration_cast<milliseconds>(stop-start).count()
+         << " milliseconds, " << setw(10) << allocations - before << " allocations (" << postings << " postings)" << endl;
+}
+
+/// Builds an inverted index, mapping each word to the documents containing it, for the
+/// given number of postings drawn from a vocabulary with a skewed (roughly Zipfian)
+/// distribution, so that a few words have a large share of the postings.
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 5000000};              // number of postings (default 5000000)
+    int vocabulary{argc >= 3 ? stoi(argv[2]) : 100000};      // number of distinct words (default 100000)
+
+    mt19937 rng(n);
+    uniform_real_distribution<double> unit(0, 1);
+    vector<pair<int,int>> postings;                          // (word, document) pairs
+    for (int j = 0; j < n; j++)
+        postings.push_back({int(pow(vocabulary, unit(rng))) - 1, j / 100});
+
+    {
+        auto start = high_resolution_clock::now();
+        long before{allocations};
+        OurMultimap<int,int> index;
+        for (auto p : postings)
+            index.insert(p);
+        report("OurMultimap insert", start, before, index.size());
+    }
+    {
+        auto start = high_resolution_clock::now();
+        long before{allocations};
+        FlatMultimap<int,int> index;
+        for (auto [word, doc] : postings)
+            index.insert(word, doc);
+        report("FlatMultimap insert", start, before, index.size());
+    }
+    FlatMultimap<int,int> flat;
+    {
+        auto start = high_resolution_clock::now();
+        long before{allocations};
+        flat.insert_all(postings.begin(), postings.end());
+        report("FlatMultimap insert_all", start, before, flat.size());
+    }
+    FrozenMultimap<int,int> frozen;
+    {
+        auto start = high_resolution_clock::now();
+        long before{allocations};
+        frozen = FrozenMultimap<int,int>(flat);
+        report("FrozenMultimap from flat", start, before, frozen.size());
+    }
+
+    // sum the documents of every word, as a query would scan postings lists
+    long total{0};
+    long before{allocations};
+    auto start = high_resolution_clock::now();
+    for (int word = 0; word < vocabulary; word++)
+        for (int doc : flat.equal_range(word))
+            total += doc;
+    report("FlatMultimap scan", start, before, flat.size());
+    start = high_resolution_clock::now();
+    for (int word = 0; word < vocabulary; word++)
+        for (int doc : frozen.equal_range(word))
+            total -= doc;
+    report("FrozenMultimap scan", start, before, frozen.size());
+    return (total == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*
+Sample output (default arguments):
+
+OurMultimap insert             2283 milliseconds,    5099784 allocations (5000000 postings)
+FlatMultimap insert            2725 milliseconds,     586035 allocations (5000000 postings)
+FlatMultimap insert_all         708 milliseconds,     199570 allocations (5000000 postings)
+FrozenMultimap from flat          9 milliseconds,          4 allocations (5000000 postings)
+FlatMultimap scan                17 milliseconds,          0 allocations (5000000 postings)
+FrozenMultimap scan              15 milliseconds,          0 allocations (5000000 postings)
+
+*/
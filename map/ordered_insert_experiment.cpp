@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>    // provides std::sqrt
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <utility>
+#include <vector>
+
+#include "ordered_table_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// Reports the time since start, and the size of the map that was loaded
+void report(const string& name, high_resolution_clock::time_point start, int size) {
+    auto stop = high_resolution_clock::now();
+    cout << setw(26) << left << name << right << setw(7) << duration_cast<milliseconds>(stop-start).count()
+         << " milliseconds (" << size << " entries)" << endl;
+}
+
+/// Loads n entries with random keys into an OrderedTableMap, with one put per entry
+/// without a buffer (for n up to max_unbuffered) and with buffers of various sizes,
+/// and also sorts the entries and uses bulk_load
+void experiment(int n, int max_unbuffered) {
+    mt19937 rng(n);
+    vector<pair<int,int>> items;
+    for (int j = 0; j < n; j++)
+        items.push_back({int(rng() >> 1), j});
+    cout << endl << n << " insertions:" << endl;
+
+    if (n <= max_unbuffered) {
+        auto start = high_resolution_clock::now();
+        OrderedTableMap<int,int> map;
+        for (auto [k, v] : items)
+            map.put(k, v);
+        report("put, unbuffered", start, map.size());
+    }
+    int root_n = sqrt(n);
+    for (int capacity : {root_n / 4, root_n, 4 * root_n}) {
+        auto start = high_resolution_clock::now();
+        OrderedTableMap<int,int> map;
+        map.set_buffer_capacity(capacity);
+        for (auto [k, v] : items)
+            map.put(k, v);
+        map.flush();
+        report("put, buffer of " + to_string(capacity), start, map.size());
+    }
+    auto start = high_resolution_clock::now();
+    vector<pair<int,int>> sorted{items};
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end(),
+                        [](auto a, auto b) { return a.first == b.first; }), sorted.end());
+    OrderedTableMap<int,int> map;
+    map.bulk_load(sorted.begin(), sorted.end());
+    report("sort and bulk_load", start, map.size());
+}
+
+/// The command line arguments set the smallest and largest number of insertions (which
+/// are multiplied by 10 in between), and the largest number tried without a buffer.
+int main(int argc, char* argv[]) {
+    int smallest{argc >= 2 ? stoi(argv[1]) : 10000};         // fewest insertions (default 10000)
+    int largest{argc >= 3 ? stoi(argv[2]) : 1000000};        // most insertions (default 1000000)
+    int max_unbuffered{argc >= 4 ? stoi(argv[3]) : 100000};  // (default 100000)
+
+    for (int n = smallest; n <= largest; n *= 10)
+        experiment(n, max_unbuffered);
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (default arguments):
+
+10000 insertions:
+put, unbuffered                 4 milliseconds (10000 entries)
+put, buffer of 25               6 milliseconds (10000 entries)
+put, buffer of 100              3 milliseconds (10000 entries)
+put, buffer of 400              2 milliseconds (10000 entries)
+sort and bulk_load              1 milliseconds (10000 entries)
+
+100000 insertions:
+put, unbuffered               629 milliseconds (99994 entries)
+put, buffer of 79             124 milliseconds (99994 entries)
+put, buffer of 316             55 milliseconds (99994 entries)
+put, buffer of 1264            44 milliseconds (99994 entries)
+sort and bulk_load             13 milliseconds (99994 entries)
+
+1000000 insertions:
+put, buffer of 250           3418 milliseconds (999765 entries)
+put, buffer of 1000          1081 milliseconds (999765 entries)
+put, buffer of 4000           713 milliseconds (999765 entries)
+sort and bulk_load            150 milliseconds (999765 entries)
+
+*/
@@ -1,105 +1,223 @@
 #pragma once
 #include <functional>    // defines std::less
 #include <stdexcept>
+#include <utility>       // defines std::move, std::forward
 #include <vector>
 #include "abstract_map.h"
 
 namespace dsac::map {
 
+/// A sorted map stored in a vector. Inserting a new key shifts all larger entries, so by
+/// default each put takes O(n) time. For faster loading, set_buffer_capacity(b) makes new
+/// keys go to a small sorted side buffer instead, which is merged into the main table
+/// whenever it fills (in the style of a log-structured merge tree), for O(n/b + b)
+/// amortized time per insertion. Searches check both vectors, and iterators traverse the
+/// two of them together in key order. A sorted range may also be added all at once with
+/// bulk_load.
 template <typename Key, typename Value, typename Compare=std::less<Key>>
 class OrderedTableMap : public AbstractMap<Key,Value> {
   protected:
     typedef AbstractMap<Key,Value> Base;                     // shorthand for the base class
   public:
-    using typename Base::Entry, typename Base::const_iterator, Base::erase;
+    using typename Base::Entry, typename Base::const_iterator;
+    using Base::erase;
   protected:
-    using typename Base::abstract_iter_rep, Base::get_rep;
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator;
 
     std::vector<Entry> table;                                // map entries are stored in a vector
+    std::vector<Entry> buffer;                               // recently added entries, also sorted
+    int buffer_cap{0};                                       // maximum size of buffer
     Compare less_than;                                       // less_than(a,b) defines "a < b" relationship
 
-    int lower_bound_index(const Key& target) const {
-        int low(0), high(table.size()-1);
+    int lower_bound_index(const std::vector<Entry>& vec, const Key& target) const {
+        int low(0), high(vec.size()-1);
         while (low <= high) {
             int mid{(low + high) / 2};
-            if (less_than(table[mid].key(), target))         // lower bound must be right of mid
+            if (less_than(vec[mid].key(), target))           // lower bound must be right of mid
                 low = mid + 1;
             else
                 high = mid - 1;                              // lower bound is either mid or left of mid
         }
         return low;                                          // lower bound at low (which equals 1+high)
     }
-    
-    // a position within our map is described by an iterator in the underlying list
-    class iter_rep : public abstract_iter_rep {              // specialize abstract version
+
+    int lower_bound_index(const Key& target) const { return lower_bound_index(table, target); }
+
+    // returns true if index j of vec holds key k
+    bool holds(const std::vector<Entry>& vec, int j, const Key& k) const {
+        return j < vec.size() && !less_than(k, vec[j].key());
+    }
+
+    // Merges the (sorted) entries of extra into table, in time linear in their total size.
+    // If a key appears in both, the entry from extra is kept. The merge works from the back,
+    // within the table itself, so that no other vector is needed.
+    void merge_into_table(std::vector<Entry>& extra) {
+        int i{int(table.size()) - 1}, j{int(extra.size()) - 1};
+        table.resize(table.size() + extra.size());
+        int w{int(table.size())};                                // table[w..] holds merged entries
+        while (j >= 0) {
+            if (i >= 0 && less_than(extra[j].key(), table[i].key()))
+                table[--w] = std::move(table[i--]);
+            else {
+                if (i >= 0 && !less_than(table[i].key(), extra[j].key()))
+                    i--;                                         // equal keys; discard the old entry
+                table[--w] = std::move(extra[j--]);
+            }
+        }
+        if (w > i + 1)                                           // close the gap left by duplicates
+            table.erase(table.begin() + i + 1, table.begin() + w);
+        extra.clear();
+    }
+
+    // A position within our map is described by an index in each of the two vectors: the
+    // entry is whichever of table[i] and buffer[b] has the smaller key (with table.size()
+    // or buffer.size() indicating that a vector is exhausted). Without a buffer, b is 0.
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {    // specialize abstract version
       public:
-        const std::vector<Entry>* vec;
-        int index;
-        iter_rep(const std::vector<Entry>* v, int i) : vec{v}, index{i} {}
+        const OrderedTableMap* map;
+        int i;                                                          // index within table
+        int b;                                                          // index within buffer
+        iter_rep(const OrderedTableMap* m, int i, int b) : map{m}, i{i}, b{b} {}
 
-        const Entry& entry() const { return (*vec)[index]; }
-        void advance() { ++index; }
-        abstract_iter_rep* clone() const { return new iter_rep(vec,index); }
+        // returns true if the current entry is from the buffer
+        bool in_buffer() const {
+            return b < map->buffer.size() &&
+                   (i == map->table.size() || map->less_than(map->buffer[b].key(), map->table[i].key()));
+        }
+        const Entry& entry() const { return in_buffer() ? map->buffer[b] : map->table[i]; }
+        void advance() {
+            if (in_buffer()) ++b; else ++i;
+        }
+        void retreat() {                                    // step back in whichever vector has the larger key
+            if (b > 0 && (i == 0 || map->less_than(map->table[i-1].key(), map->buffer[b-1].key())))
+                --b;
+            else
+                --i;
+        }
         bool equals(const abstract_iter_rep* other) const {
             const iter_rep* p = dynamic_cast<const iter_rep*>(other);   // cast abstract argument to our iter_rep
-            return p != nullptr && vec == p->vec && index == p->index;
+            return p != nullptr && map == p->map && i == p->i && b == p->b;
         }
     };  //------- end of class iter_rep --------
-    
+    friend iter_rep;
+
+    const_iterator position(int i, int b) const { return make_iterator(iter_rep(this, i, b)); }
+
   public:
     /// Creates an empty map
     OrderedTableMap() {}
 
     /// Returns the number of entries in the map
-    int size() const { return table.size(); }
+    int size() const { return table.size() + buffer.size(); }
+
+    /// Returns the maximum number of entries held in the insertion buffer (0 if unbuffered)
+    int buffer_capacity() const { return buffer_cap; }
+
+    /// Sets the maximum number of newly inserted entries that are held in a side buffer
+    /// before being merged into the table (0, the default, inserts into the table directly).
+    /// A capacity of a few times the square root of the expected size works well.
+    void set_buffer_capacity(int capacity) {
+        if (capacity < 0)
+            throw std::invalid_argument("buffer capacity must be nonnegative");
+        buffer_cap = capacity;
+        if (buffer.size() > buffer_cap)
+            flush();
+    }
+
+    /// Merges all buffered entries into the table
+    void flush() { merge_into_table(buffer); }
 
     /// Returns a const_iterator to first entry
-    const_iterator begin() const { return const_iterator(new iter_rep(&table, 0)); }
+    const_iterator begin() const { return position(0, 0); }
 
     /// Returns a const_iterator representing the end
-    const_iterator end() const { return const_iterator(new iter_rep(&table, table.size())); }
+    const_iterator end() const { return position(table.size(), buffer.size()); }
 
     /// Returns a const_iterator to the entry with a given key, or end() if no such entry exists
     const_iterator find(const Key& k) const {
         int j{lower_bound_index(k)};
-        if (j < table.size() && !less_than(k, table[j].key()))            // exact match
-            return const_iterator(new iter_rep(&table, j));               // at index j
+        int b{lower_bound_index(buffer, k)};
+        if (holds(table, j, k) || holds(buffer, b, k))                    // exact match
+            return position(j, b);
         else
-            return const_iterator(new iter_rep(&table, table.size()));    // unsuccessful search
+            return end();                                                 // unsuccessful search
     }
 
+  protected:
+    // add/update Entry(k,v), copying or moving k and v as given
+    template <typename K, typename V>
+    const_iterator insert(K&& k, V&& v) {
+        int j{lower_bound_index(k)};
+        if (holds(table, j, k)) {                                         // exact match
+            this->update_value(table[j], std::forward<V>(v));             // overwrite existing value
+            return position(j, lower_bound_index(buffer, k));
+        }
+        int b{lower_bound_index(buffer, k)};
+        if (holds(buffer, b, k))
+            this->update_value(buffer[b], std::forward<V>(v));
+        else if (buffer_cap == 0)
+            table.emplace(table.begin() + j, std::forward<K>(k), std::forward<V>(v));   // insert at index j
+        else {
+            buffer.emplace(buffer.begin() + b, std::forward<K>(k), std::forward<V>(v));
+            if (buffer.size() > buffer_cap) {                             // merge a full buffer
+                flush();
+                return position(j + b, 0);                                // j + b entries precede k
+            }
+        }
+        return position(j, b);                                            // either way, entry is at (j, b)
+    }
+
+  public:
     /// Associates given key with given value. If key already exists previous value is overwritten.
     /// Returns a const_iterator to the entry associated with the key
-    const_iterator put(const Key& k, const Value& v) {
-        int j{lower_bound_index(k)};
-        if (j < table.size() && !less_than(k, table[j].key()))            // exact match
-            this->update_value(table[j],v);                               // overwrite existing value
-        else
-            table.insert(table.begin() + j, Entry(k,v));                  // insert at index j
-        return const_iterator(new iter_rep(&table, j));                   // either way, entry is at index j
+    const_iterator put(const Key& k, const Value& v) { return insert(k, v); }
+
+    /// Same as above, but moving the key and value into the map
+    const_iterator put(Key&& k, Value&& v) { return insert(std::move(k), std::move(v)); }
+
+    /// Adds each (key, value) pair in the range [first, last), which must be in strictly
+    /// increasing order of key, as if by put; invalid_argument is thrown if it is not.
+    /// This takes time linear in the sizes of the range and the map.
+    template <typename InputIt>
+    void bulk_load(InputIt first, InputIt last) {
+        std::vector<Entry> extra;
+        for ( ; first != last; ++first) {
+            if (!extra.empty() && !less_than(extra.back().key(), first->first))
+                throw std::invalid_argument("bulk_load requires keys in increasing order");
+            extra.emplace_back(first->first, first->second);
+        }
+        flush();
+        merge_into_table(extra);
     }
 
     /// Removes the entry indicated by the given iterator, and returns const_iterator to next entry in iteration order
     const_iterator erase(const_iterator loc) {
-        int j = dynamic_cast<iter_rep*>(get_rep(loc))->index;
-        table.erase(table.begin() + j);
-        return const_iterator(new iter_rep(&table, j));
+        iter_rep* rep{dynamic_cast<iter_rep*>(get_rep(loc))};
+        int i{rep->i}, b{rep->b};
+        if (rep->in_buffer())
+            buffer.erase(buffer.begin() + b);
+        else
+            table.erase(table.begin() + i);
+        return position(i, b);
     }
 
     /// Returns a const_iterator to the first entry with key greater than or equal to k, or end() if no such entry exists
     const_iterator lower_bound(const Key& k) const {
-        int j{lower_bound_index(k)};
-        return const_iterator(new iter_rep(&table, j));
+        return position(lower_bound_index(k), lower_bound_index(buffer, k));
     }
-    
+
     /// Returns a const_iterator to the first entry with key strictly greater than k, or end() if no such entry exists
     const_iterator upper_bound(const Key& k) const {
         int j{lower_bound_index(k)};
-        if (j < table.size() && !less_than(k, table[j].key()))         // exact match
+        int b{lower_bound_index(buffer, k)};
+        if (holds(table, j, k))                                        // exact match
             j++;                                                       // advance past the match
-        return const_iterator(new iter_rep(&table, j));
+        else if (holds(buffer, b, k))
+            b++;
+        return position(j, b);
     }
-    
+
 };
 
 } // namespace dsac::map
@@ -0,0 +1,55 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>   // provides std::unique_ptr
+#include <string>   // provides std::stoi
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "parallel_word_count.h"
+#include "probe_hash_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// Reports the most frequent word within the given files, as word_count does for standard
+/// input, counting with several threads. Usage: parallel_word_count [-t threads] file...
+/// (by default, one thread per hardware thread).
+int main(int argc, char* argv[]) {
+    int threads{max(1, int(thread::hardware_concurrency()))};
+    int first{1};
+    if (argc >= 3 && string(argv[1]) == "-t") {
+        threads = stoi(argv[2]);
+        first = 3;
+    }
+    if (first >= argc) {
+        cerr << "Usage: " << argv[0] << " [-t threads] file..." << endl;
+        return EXIT_FAILURE;
+    }
+
+    vector<unique_ptr<MappedText>> files;
+    vector<string_view> texts;
+    try {
+        for (int j = first; j < argc; j++) {
+            files.push_back(make_unique<MappedText>(argv[j]));
+            texts.push_back(files.back()->text());
+        }
+    } catch (runtime_error& e) {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+    ProbeHashMap<string_view,int> freq{parallel_count_words<ProbeHashMap<string_view,int>>(texts, threads)};
+
+    int max_count{0};
+    string_view max_word{""};
+    for (const auto& entry : freq) {
+        if (entry.value() > max_count) {
+            max_count = entry.value();
+            max_word = entry.key();
+        }
+    }
+
+    cout << "The most frequent word is '" << max_word
+         << "' with " << max_count << " occurrences." << endl;
+    return EXIT_SUCCESS;
+}
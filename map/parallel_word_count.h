@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>                      // defines std::max, std::min
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>                        // POSIX open
+#include <sys/mman.h>                     // POSIX mmap, munmap, madvise
+#include <sys/stat.h>                     // POSIX fstat
+#include <unistd.h>                       // POSIX close
+
+namespace dsac::map {
+
+/// The contents of a file, memory-mapped read-only rather than read into a buffer
+class MappedText {
+  private:
+    const char* base{nullptr};
+    std::size_t length{0};
+
+  public:
+    /// Maps the given file, throwing runtime_error if it cannot be opened or mapped
+    explicit MappedText(const std::string& path) {
+        int fd{open(path.c_str(), O_RDONLY)};
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("cannot read " + path);
+        }
+        length = info.st_size;
+        if (length > 0) {                                           // cannot map an empty file
+            void* p{mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0)};
+            if (p == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            madvise(p, length, MADV_SEQUENTIAL);                    // read ahead aggressively
+            base = static_cast<const char*>(p);
+        }
+        close(fd);                                                  // mapping remains valid
+    }
+
+    MappedText(const MappedText&) = delete;
+    MappedText& operator=(const MappedText&) = delete;
+
+    ~MappedText() {
+        if (base != nullptr)
+            munmap(const_cast<char*>(base), length);
+    }
+
+    /// Returns the contents of the file
+    std::string_view text() const { return std::string_view(base, length); }
+};
+
+// Returns true for the characters that separate words when reading with operator>>
+// (the whitespace of the "C" locale)
+inline bool is_separator(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// Splits text into at most n pieces of roughly equal length, moving each cut forward to
+/// the next separator so that no word is divided between pieces.
+inline std::vector<std::string_view> split_words(std::string_view text, int n) {
+    std::vector<std::string_view> pieces;
+    std::size_t start{0};
+    for (int j = 1; j <= n && start < text.size(); j++) {
+        std::size_t stop{j == n ? text.size() : std::max(start, text.size() / n * j)};
+        while (stop < text.size() && !is_separator(text[stop]))
+            stop++;
+        if (stop > start)
+            pieces.push_back(text.substr(start, stop - start));
+        start = stop;
+    }
+    return pieces;
+}
+
+/// Adds one to freq's count for each occurrence of a word within text. Words are
+/// separated by whitespace, as with operator>>, and keys are views into the text itself.
+template <typename Map>
+void count_words(std::string_view text, Map& freq) {
+    std::size_t j{0};
+    while (true) {
+        while (j < text.size() && is_separator(text[j])) j++;
+        if (j == text.size()) break;
+        std::size_t start{j};
+        while (j < text.size() && !is_separator(text[j])) j++;
+        freq.upsert(text.substr(start, j - start), 1, [](int& count) { count++; });
+    }
+}
+
+/// Counts the words of the given texts using the given number of threads. Each text is
+/// split into pieces on word boundaries; threads claim pieces one at a time and count
+/// them in a map of their own, so that they never contend for a lock. The private maps
+/// are then merged into the largest of them, which is returned. Keys of the returned map
+/// are views into the texts, so the texts must outlive it.
+template <typename Map>
+Map parallel_count_words(const std::vector<std::string_view>& texts, int threads) {
+    if (threads <= 0)
+        throw std::invalid_argument("number of threads must be positive");
+    std::vector<std::string_view> pieces;
+    for (std::string_view text : texts)
+        for (std::string_view piece : split_words(text, 4 * threads))   // extra pieces balance the load
+            pieces.push_back(piece);
+
+    std::vector<Map> local(threads);
+    std::atomic<int> next{0};
+    auto work = [&](int t) {
+        for (int j = next++; j < pieces.size(); j = next++)
+            count_words(pieces[j], local[t]);
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(work, t);
+    work(0);
+    for (std::thread& w : workers)
+        w.join();
+
+    int biggest{0};
+    for (int t = 1; t < threads; t++)
+        if (local[t].size() > local[biggest].size())
+            biggest = t;
+    Map result{std::move(local[biggest])};
+    for (int t = 0; t < threads; t++)
+        if (t != biggest)
+            for (const auto& entry : local[t]) {
+                int extra{entry.value()};
+                result.upsert(entry.key(), extra, [extra](int& count) { count += extra; });
+            }
+    return result;
+}
+
+} // namespace dsac::map
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <vector>
+
+#include "chain_hash_map.h"
+#include "perfect_hash_map.h"
+#include "probe_hash_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// Returns the number of the given keys found in the map, reporting the time taken
+template <typename Map>
+long lookups(const string& name, const Map& map, const vector<int>& keys) {
+    long found{0};
+    auto start = high_resolution_clock::now();
+    for (int k : keys)
+        if (map.contains(k)) found++;
+    auto stop = high_resolution_clock::now();
+    double elapsed = duration_cast<microseconds>(stop-start).count();
+    cout << setw(16) << name << ": " << setw(9) << fixed << setprecision(2)
+         << keys.size() / elapsed << " million lookups per second (" << found << " found)" << endl;
+    return found;
+}
+
+/// Builds a ProbeHashMap of n random keys, and a PerfectHashMap from a ChainHashMap with
+/// the same entries, reporting the build times; then compares lookup throughput for
+/// n successful and n unsuccessful searches.
+void experiment(int n) {
+    mt19937 rng(n);
+    vector<int> keys, absent;
+    for (int j = 0; j < n; j++) {
+        keys.push_back(2 * (rng() >> 2));                        // even keys are present
+        absent.push_back(2 * (rng() >> 2) + 1);                  // odd keys are not
+    }
+    cout << endl << n << " entries:" << endl;
+
+    auto start = high_resolution_clock::now();
+    ProbeHashMap<int,int> probe;
+    for (int j = 0; j < n; j++)
+        probe.put(keys[j], j);
+    auto stop = high_resolution_clock::now();
+    cout << "ProbeHashMap build:   " << setw(6) << duration_cast<milliseconds>(stop-start).count()
+         << " milliseconds" << endl;
+
+    ChainHashMap<int,int> chain;
+    for (int j = 0; j < n; j++)
+        chain.put(keys[j], j);
+    start = high_resolution_clock::now();
+    PerfectHashMap<int,int> perfect(chain);
+    stop = high_resolution_clock::now();
+    cout << "PerfectHashMap build: " << setw(6) << duration_cast<milliseconds>(stop-start).count()
+         << " milliseconds (from a filled ChainHashMap; "
+         << setprecision(1) << fixed << perfect.bits_per_key() << " bits of metadata per key)" << endl;
+
+    lookups("ProbeHashMap", probe, keys);
+    lookups("PerfectHashMap", perfect, keys);
+    lookups("ProbeHashMap", probe, absent);
+    lookups("PerfectHashMap", perfect, absent);
+}
+
+/// The command line arguments set the smallest and largest number of entries
+/// (which are multiplied by 10 in between).
+int main(int argc, char* argv[]) {
+    int smallest{argc >= 2 ? stoi(argv[1]) : 10000};         // fewest entries (default 10000)
+    int largest{argc >= 3 ? stoi(argv[2]) : 1000000};        // most entries (default 1000000)
+
+    for (int n = smallest; n <= largest; n *= 10)
+        experiment(n);
+    return EXIT_SUCCESS;
+}
+
+/* Sample output
+
+10000 entries:
+ProbeHashMap build:        0 milliseconds
+PerfectHashMap build:      4 milliseconds (from a filled ChainHashMap; 4.9 bits of metadata per key)
+    ProbeHashMap:     28.41 million lookups per second (10000 found)
+  PerfectHashMap:     36.63 million lookups per second (10000 found)
+    ProbeHashMap:     26.04 million lookups per second (0 found)
+  PerfectHashMap:     36.63 million lookups per second (0 found)
+
+100000 entries:
+ProbeHashMap build:        8 milliseconds
+PerfectHashMap build:     52 milliseconds (from a filled ChainHashMap; 3.7 bits of metadata per key)
+    ProbeHashMap:     16.23 million lookups per second (100000 found)
+  PerfectHashMap:     29.03 million lookups per second (100000 found)
+    ProbeHashMap:     27.69 million lookups per second (0 found)
+  PerfectHashMap:     30.54 million lookups per second (0 found)
+
+1000000 entries:
+ProbeHashMap build:       87 milliseconds
+PerfectHashMap build:    660 milliseconds (from a filled ChainHashMap; 3.6 bits of metadata per key)
+    ProbeHashMap:     10.27 million lookups per second (1000000 found)
+  PerfectHashMap:     14.30 million lookups per second (1000000 found)
+    ProbeHashMap:     15.02 million lookups per second (0 found)
+  PerfectHashMap:      9.37 million lookups per second (0 found)
+
+*/
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "abstract_map.h"
+#include "table_sizing.h"                 // defines mix_bits
+
+#include <algorithm>                      // defines std::sort, std::unique, std::lower_bound
+#include <cstddef>
+#include <cstdint>
+#include <functional>                     // defines std::hash
+#include <stdexcept>
+#include <utility>                        // defines std::pair, std::move
+#include <vector>
+
+namespace dsac::map {
+
+/// A read-only map built from the entries of another map, using a minimal perfect hash
+/// function in the style of PTHash: keys are grouped into small buckets, and each bucket
+/// is assigned a "pilot" value, found by trial while building, that sends all of its keys
+/// to distinct free positions. Positions range over slightly more cells than there are
+/// entries, which makes pilots much quicker to find, and the few keys that land beyond the
+/// last entry are redirected to the unused cells before it, so the table has exactly one
+/// cell per entry. Each lookup then computes one position and compares one key.
+///
+/// Most pilots are small and many buckets share the same pilot, so pilots are stored as
+/// in PTHash's dictionary encoding: a table of the distinct pilots, and for each bucket the
+/// index of its pilot within that table, packed into just enough bits. The redirection
+/// array is likewise packed into just enough bits for a cell number. For a large map, the
+/// extra data takes under four bits per key in all (as reported by bits_per_key).
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class PerfectHashMap : public AbstractMap<Key,Value> {
+  protected:
+    typedef AbstractMap<Key,Value> Base;
+  public:
+    using typename Base::Entry;
+    using typename Base::const_iterator;
+    using Base::erase;
+  protected:
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator;
+
+    static constexpr int LAMBDA{4};                  // average number of keys per bucket
+    static constexpr int SLACK{20};                  // one extra position per SLACK entries
+
+    // A fixed-length array of nonnegative integers, each stored in the same number of bits
+    // (enough for the largest), packed into 64-bit words
+    class PackedArray {
+        std::vector<std::uint64_t> words;
+        int width{0};                                // bits per element (0 if all are zero)
+      public:
+        PackedArray() = default;
+        explicit PackedArray(const std::vector<std::uint32_t>& values) {
+            std::uint32_t largest{0};
+            for (std::uint32_t v : values) largest = std::max(largest, v);
+            while (width < 32 && (std::uint64_t(1) << width) <= largest) width++;
+            words.assign((values.size() * width + 63) / 64 + 1, 0);          // (one spare word)
+            for (std::size_t j = 0; j < values.size(); j++) {
+                std::size_t bit{j * width};
+                words[bit / 64] |= std::uint64_t(values[j]) << (bit % 64);
+                if (bit % 64 + width > 64)                                  // element spans two words
+                    words[bit / 64 + 1] |= std::uint64_t(values[j]) >> (64 - bit % 64);
+            }
+        }
+
+        std::uint32_t operator[](std::size_t j) const {
+            std::size_t bit{j * width};
+            std::uint64_t x{words[bit / 64] >> (bit % 64)};
+            if (bit % 64 + width > 64)
+                x |= words[bit / 64 + 1] << (64 - bit % 64);
+            return x & ((std::uint64_t(1) << width) - 1);
+        }
+
+        std::size_t bits() const { return 64 * words.size(); }            // storage used
+    }; // end class PackedArray
+
+    Hash hash;
+    std::vector<Entry> table;                        // table[j] is the entry placed at position j
+    int num_buckets{0};                              // number of buckets of keys
+    PackedArray pilot_index;                         // pilot_index[b] locates bucket b's pilot in dictionary
+    std::vector<std::uint64_t> dictionary;           // pilot_hash of each distinct pilot
+    PackedArray remap;                               // remap[p] is the cell for position table.size()+p
+    int positions{0};                                // number of possible positions
+
+    std::uint64_t full_hash(const Key& k) const { return mix_bits(hash(k)); }
+
+    // Buckets are skewed as in PTHash: 60% of keys go to the first 30% of buckets, which are
+    // then placed while the table is still mostly empty, leaving the last, nearly full stage
+    // to buckets of only one or two keys. The high bits of the hash pick a bucket within a
+    // group, using Lemire's fastrange reduction.
+    int bucket_of(std::uint64_t h) const {
+        std::uint64_t dense{(num_buckets * std::uint64_t(3) + 9) / 10};     // size of first group
+        std::uint64_t x{h >> 32};
+        if ((h & 0xffffffff) < 0x99999999)                                // (0.6 * 2^32)
+            return (x * dense) >> 32;
+        return dense + ((x * (num_buckets - dense)) >> 32);
+    }
+
+    // a pilot is scrambled once, and then combined with each key of its bucket
+    static std::uint64_t pilot_hash(std::uint32_t pilot) { return mix_bits(pilot + 1); }
+
+    // position (in range [0, positions)) of a key with hash h, given its bucket's pilot hash
+    int position(std::uint64_t h, std::uint64_t ph) const {
+        std::uint64_t x{mix_bits(h ^ ph)};
+        return ((x >> 32) * static_cast<std::uint64_t>(positions)) >> 32;
+    }
+
+    // table cell for a key with hash h
+    int cell(std::uint64_t h) const {
+        int p{position(h, dictionary[pilot_index[bucket_of(h)]])};
+        return (p < table.size() ? p : remap[p - table.size()]);
+    }
+
+    // Builds the table from the entries of the source map
+    void build(const AbstractMap<Key,Value>& source) {
+        int n{source.size()};
+        num_buckets = n / LAMBDA + 2;                                      // each group non-empty
+        std::vector<std::uint32_t> pilots(num_buckets, 0);                 // pilots[b] is bucket b's pilot
+        std::vector<Entry> entries;
+        std::vector<std::pair<std::uint64_t,int>> keyed;                  // (hash, entry index)
+        entries.reserve(n);
+        keyed.reserve(n);
+        for (const Entry& e : source) {
+            keyed.push_back({full_hash(e.key()), int(entries.size())});
+            entries.push_back(e);
+        }
+        std::sort(keyed.begin(), keyed.end());
+        for (int j = 1; j < n; j++)
+            if (keyed[j].first == keyed[j-1].first)
+                throw std::runtime_error("cannot build perfect hash: two keys have equal hash codes");
+
+        // group keys by bucket, then place buckets from largest to smallest
+        std::vector<std::vector<int>> members(num_buckets);                // indices into keyed
+        for (int j = 0; j < n; j++)
+            members[bucket_of(keyed[j].first)].push_back(j);
+        std::vector<int> order(num_buckets);
+        for (int b = 0; b < order.size(); b++) order[b] = b;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](int a, int b) { return members[a].size() > members[b].size(); });
+
+        positions = n + n / SLACK;
+        table.assign(n, Entry());
+        std::vector<char> taken(positions, false);
+        std::vector<int> spots;
+        for (int b : order) {
+            if (members[b].empty()) break;
+            for (std::uint32_t p = 0; ; p++) {                             // try successive pilots
+                if (p == UINT32_MAX)
+                    throw std::runtime_error("cannot build perfect hash: no pilot found");
+                pilots[b] = p;
+                std::uint64_t ph{pilot_hash(p)};
+                spots.clear();
+                bool ok{true};
+                for (int j : members[b]) {
+                    int s{position(keyed[j].first, ph)};
+                    if (taken[s] || std::find(spots.begin(), spots.end(), s) != spots.end()) {
+                        ok = false;
+                        break;
+                    }
+                    spots.push_back(s);
+                }
+                if (ok) break;
+            }
+            for (int i = 0; i < members[b].size(); i++)
+                taken[spots[i]] = true;
+        }
+
+        // encode the pilots as indices into a sorted dictionary of the distinct pilots
+        std::vector<std::uint32_t> distinct{pilots};
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        dictionary.clear();
+        for (std::uint32_t p : distinct)
+            dictionary.push_back(pilot_hash(p));
+        for (std::uint32_t& p : pilots)
+            p = std::lower_bound(distinct.begin(), distinct.end(), p) - distinct.begin();
+        pilot_index = PackedArray(pilots);
+
+        // redirect each position beyond the table to a distinct unused cell
+        std::vector<std::uint32_t> cells(positions - n, 0);
+        int free_cell{0};
+        for (int p = n; p < positions; p++)
+            if (taken[p]) {
+                while (taken[free_cell]) free_cell++;
+                cells[p - n] = free_cell++;
+            }
+        remap = PackedArray(cells);
+        for (const std::pair<std::uint64_t,int>& key : keyed)
+            table[cell(key.first)] = std::move(entries[key.second]);
+    }
+
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {     // specialize abstract version
+      public:
+        const PerfectHashMap* map{nullptr};
+        int loc;                                                         // index within table
+        iter_rep(const PerfectHashMap* m, int j) : map{m}, loc{j} {}
+        const Entry& entry() const { return map->table[loc]; }
+        void advance() { ++loc; }
+        bool equals(const abstract_iter_rep* other) const {
+            const iter_rep* p = dynamic_cast<const iter_rep*>(other);
+            return p != nullptr && map == p->map && loc == p->loc;
+        }
+    }; // end class iter_rep
+    friend iter_rep;
+
+  public:
+    /// Builds a map with the same entries as the given map (which may be of any type).
+    /// Throws runtime_error in the unlikely event that two keys have equal hash codes.
+    explicit PerfectHashMap(const AbstractMap<Key,Value>& source) { build(source); }
+
+    /// Returns the number of entries in the map
+    int size() const { return table.size(); }
+
+    /// Returns the number of bits of lookup metadata per entry (the packed pilot indices,
+    /// the dictionary of distinct pilots, and the packed redirection array)
+    double bits_per_key() const {
+        if (table.empty()) return 0;
+        return double(pilot_index.bits() + 64 * dictionary.size() + remap.bits()) / table.size();
+    }
+
+    const_iterator begin() const { return make_iterator(iter_rep(this, 0)); }
+    const_iterator end() const { return make_iterator(iter_rep(this, table.size())); }
+
+    /// Returns a const_iterator to the entry with a given key, or end() if no such entry exists
+    const_iterator find(const Key& k) const {
+        if (table.empty()) return end();
+        int j{cell(full_hash(k))};
+        return (table[j].key() == k ? make_iterator(iter_rep(this, j)) : end());
+    }
+
+    /// The map is read-only, so put throws logic_error
+    const_iterator put(const Key&, const Value&) { throw std::logic_error("PerfectHashMap is read-only"); }
+    const_iterator put(Key&&, Value&&) { throw std::logic_error("PerfectHashMap is read-only"); }
+
+    /// The map is read-only, so erase throws logic_error
+    const_iterator erase(const_iterator) { throw std::logic_error("PerfectHashMap is read-only"); }
+};
+
+} // namespace dsac::map
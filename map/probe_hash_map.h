@@ -9,15 +9,15 @@
 
 namespace dsac::map {
 
-template <typename Key, typename Value, typename Hash = std::hash<Key>>
-class ProbeHashMap : public AbstractHashMap<Key, Value, Hash> {
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Sizing = PrimeSizing>
+class ProbeHashMap : public AbstractHashMap<Key, Value, Hash, Sizing> {
   protected:
-    typedef AbstractHashMap<Key, Value, Hash> Base;
+    typedef AbstractHashMap<Key, Value, Hash, Sizing> Base;
   public:
     using typename Base::Entry;                                  // make nested Entry public
   protected:
     using typename Base::abstract_iter_rep;
-    using Base::get_rep, Base::table_sz, Base::sz;
+    using Base::get_rep, Base::make_iterator, Base::table_sz, Base::sz;
 
     std::vector<Entry> table;
     std::vector<bool> open;           // open[j] is true if cell j has not yet been used for the map
@@ -31,7 +31,7 @@ class ProbeHashMap : public AbstractHashMap<Key, Value, Hash> {
         fill(defunct.begin(), defunct.end(), false);
     }
 
-    class iter_rep : public abstract_iter_rep {    // specialize abstract version
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {    // specialize abstract version
       public:
         const ProbeHashMap* map{nullptr};
         int loc;                                   // which cell?  (table.size() is end)
@@ -39,8 +39,6 @@ class ProbeHashMap : public AbstractHashMap<Key, Value, Hash> {
         
         const Entry& entry() const { return map->table[loc]; }
         
-        abstract_iter_rep* clone() const { return new iter_rep(*this); }
-        
         void advance() {
             do {
                 ++loc;
@@ -63,54 +61,113 @@ class ProbeHashMap : public AbstractHashMap<Key, Value, Hash> {
     ProbeHashMap() { create_table(); }                           // initializes tables
     
     const_iterator begin() const {
-        iter_rep* p = new iter_rep(this, -1);                    // artificial -1 location before advance
-        p->advance();                                            // advance to first actual entry (or end)
-        return const_iterator(p);
+        iter_rep r(this, -1);                                    // artificial -1 location before advance
+        r.advance();                                             // advance to first actual entry (or end)
+        return make_iterator(r);
     }
 
     const_iterator end() const {
-        return const_iterator(new iter_rep(this, table.size()));
+        return make_iterator(iter_rep(this, table.size()));
+    }
+
+    /// Reports the occupancy of the table, including the lengths of its clusters
+    HashMapLayout layout() const {
+        HashMapLayout result;
+        result.entries = sz;
+        result.buckets = table_sz;
+        result.bytes = table.capacity() * sizeof(Entry) + (open.capacity() + defunct.capacity()) / 8;
+        int run{0};                                              // length of current cluster
+        for (int j = 0; j < table_sz; j++) {
+            if (defunct[j]) result.defunct++;
+            if (!open[j])
+                run++;
+            else if (run > 0) {
+                result.count(run);
+                run = 0;
+            }
+        }
+        if (run > 0) result.count(run);
+        return result;
     }
     
   protected:
     // Searches for an entry with key k (which is known to have hash value h),
     // returning the index at which it was found, or returning -(a+1)
     // where a is the index of the first available slot (possibly DEFUNCT)
-    // that can be used to store a new entry.
-    int find_slot(int h, const Key& k) const {
+    // that can be used to store a new entry. The number of cells examined
+    // is added to probes.
+    int find_slot(int h, const Key& k, int& probes) const {
         int avail{-1};                         // no slot available (thus far)
         int j{h};                              // index while scanning table
         do {
+            probes++;
             if (open[j] || defunct[j]) {
                 if (avail == -1) avail = j;    // this is the first available slot!
                 if (open[j]) break;            // if empty, search fails immediately
             } else if (table[j].key() == k)
                 return j;                      // successful match
-            j = (j + 1) % table.size();        // keep looking (cyclically)
+            j = (j + 1 == table_sz ? 0 : j + 1);  // keep looking (cyclically)
         } while (j != h);                      // stop if we return to the start
         return -(avail+1);                     // search has failed
     }
 
+    // an unsuccessful search ends at an empty cell, so the table must never fill
+    void check_max_load(float f) const {
+        Base::check_max_load(f);
+        if (!(f < 1))
+            throw std::invalid_argument("max load factor must be less than 1 with linear probing");
+    }
+
+    void bucket_prefetch(int h) const { prefetch(&table[h]); }
+
     // search for entry with key k in "bucket h"
     const_iterator bucket_find(int h, const Key& k) const {
-        int j{find_slot(h, k)};
+        int probes{0};                                           // cells examined (for statistics)
+        int j{find_slot(h, k, probes)};
+        this->record_probe(probes);                              // only lookups are recorded
         if (j < 0)                                               // no match found
             return end();
-        return const_iterator(new iter_rep(this, j)); // this key has an existing entry
+        return make_iterator(iter_rep(this, j));                 // this key has an existing entry
     }
     
-    // add/update Entry(k,v) within "bucket h"
-    const_iterator bucket_put(int h, const Key& k, const Value& v)  {
-        int j{find_slot(h, k)};
+    // add/update Entry(k,v) within "bucket h", copying or moving k and v as given
+    template <typename K, typename V>
+    const_iterator bucket_insert(int h, K&& k, V&& v)  {
+        int probes{0};
+        int j{find_slot(h, k, probes)};
         if (j < 0) {                                             // no match found
             j = -(j+1);                                          // available slot
             sz++;
-            table[j] = Entry(k, v);
+            table[j] = Entry(std::forward<K>(k), std::forward<V>(v));
             open[j] = false;
+            defunct[j] = false;                                  // (slot may have been defunct)
         } else {                                                 // replace existing value
-            this->update_value(table[j], v);
+            this->update_value(table[j], std::forward<V>(v));
         }
-        return const_iterator(new iter_rep(this, j));
+        return make_iterator(iter_rep(this, j));
+    }
+
+    const_iterator bucket_put(int h, const Key& k, const Value& v) { return bucket_insert(h, k, v); }
+    const_iterator bucket_put(int h, Key&& k, Value&& v) { return bucket_insert(h, std::move(k), std::move(v)); }
+
+    // Change table size, moving each entry directly into its new slot (the first open one
+    // from its home, as the new table has no defunct cells and the keys are distinct)
+    void resize(int new_table_size) {
+        std::vector<Entry> old_table;
+        std::vector<bool> old_open, old_defunct;
+        old_table.swap(table);
+        old_open.swap(open);
+        old_defunct.swap(defunct);
+        table_sz = new_table_size;
+        create_table();
+        for (int j = 0; j < old_table.size(); j++)
+            if (!old_open[j] && !old_defunct[j]) {
+                int a{this->get_hash(old_table[j].key())};
+                while (!open[a])
+                    a = (a + 1 == table_sz ? 0 : a + 1);
+                table[a] = std::move(old_table[j]);
+                open[a] = false;
+            }
     }
     
     // remove existing entry from "bucket h"
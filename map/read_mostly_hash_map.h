@@ -0,0 +1,191 @@
+#pragma once
+
+#include "abstract_map.h"
+#include "epoch_manager.h"
+#include "table_sizing.h"
+
+#include <atomic>
+#include <functional>                     // defines std::hash
+#include <mutex>                          // defines std::mutex, std::lock_guard
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace dsac::map {
+
+/// A separate-chaining hash map for read-mostly workloads, in which queries never take
+/// a lock and never wait for writers. Writers are serialized by a mutex. Nodes are never
+/// modified once reachable: a writer builds a replacement and publishes it with a single
+/// atomic store, and unlinked nodes (and whole tables, after a resize) are deleted
+/// through epoch-based reclamation once no reader can still be visiting them.
+///
+/// Queries return copies of values, since an entry may be replaced at any moment.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Sizing = PrimeSizing>
+class ReadMostlyHashMap {
+  public:
+    typedef typename AbstractMap<Key,Value>::Entry Entry;
+
+  private:
+    struct Node {
+        const Entry entry;
+        std::atomic<Node*> next;
+        Node(const Entry& e, Node* n) : entry{e}, next{n} {}
+    };
+
+    // a table owns the nodes of its chains
+    struct Table {
+        std::vector<std::atomic<Node*>> buckets;
+        explicit Table(int n) : buckets(n) {}
+        ~Table() {
+            for (std::atomic<Node*>& b : buckets)
+                for (Node* n = b.load(std::memory_order_relaxed); n != nullptr; ) {
+                    Node* next{n->next.load(std::memory_order_relaxed)};
+                    delete n;
+                    n = next;
+                }
+        }
+    };
+
+    static constexpr int RECLAIM_BATCH{64};           // retired objects that trigger a reclaim
+
+    Hash hash;
+    std::atomic<Table*> table;
+    std::atomic<int> sz{0};
+    float max_load{1.0};
+    std::mutex write_lock;                            // held by every writer
+    mutable EpochManager epochs;
+
+    std::atomic<Node*>& bucket(Table* t, const Key& k) const {
+        return t->buckets[Sizing::index(hash(k), t->buckets.size())];
+    }
+
+    // Returns the node with key k, or nullptr (the caller must be pinned or hold write_lock)
+    const Node* locate(const Key& k) const {
+        Table* t{table.load(std::memory_order_acquire)};
+        for (Node* n = bucket(t, k).load(std::memory_order_acquire); n != nullptr;
+             n = n->next.load(std::memory_order_acquire))
+            if (n->entry.key() == k)
+                return n;
+        return nullptr;
+    }
+
+    // Returns the link (bucket or next pointer) that refers to the node with key k,
+    // or the null link at the end of its chain (the caller must hold write_lock)
+    std::atomic<Node*>* find_link(Table* t, const Key& k) {
+        std::atomic<Node*>* link{&bucket(t, k)};
+        for (Node* n = link->load(); n != nullptr && !(n->entry.key() == k); n = link->load())
+            link = &n->next;
+        return link;
+    }
+
+    // Publishes a copy of the table with n buckets, retiring the old one
+    void rehash(int n) {
+        Table* old{table.load()};
+        Table* fresh{new Table(n)};
+        for (std::atomic<Node*>& b : old->buckets)
+            for (Node* p = b.load(); p != nullptr; p = p->next.load()) {
+                std::atomic<Node*>& head{bucket(fresh, p->entry.key())};
+                head.store(new Node(p->entry, head.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+            }
+        table.store(fresh, std::memory_order_release);
+        epochs.retire(old);
+    }
+
+    void maybe_reclaim() {
+        if (epochs.pending() >= RECLAIM_BATCH)
+            epochs.reclaim();
+    }
+
+  public:
+    /// Creates an empty map
+    ReadMostlyHashMap() : table{new Table(Sizing::initial_size())} {}
+
+    ReadMostlyHashMap(const ReadMostlyHashMap&) = delete;
+    ReadMostlyHashMap& operator=(const ReadMostlyHashMap&) = delete;
+
+    ~ReadMostlyHashMap() { delete table.load(); }
+
+    /// Returns the number of entries in the map
+    int size() const { return sz.load(); }
+
+    /// Returns true if the map is empty, false otherwise
+    bool empty() const { return size() == 0; }
+
+    /// Returns true if the map contains an entry with the given key
+    bool contains(const Key& k) const {
+        auto guard{epochs.guard()};
+        return locate(k) != nullptr;
+    }
+
+    /// Returns a copy of the value associated with the given key, or nothing if not found
+    std::optional<Value> find(const Key& k) const {
+        auto guard{epochs.guard()};
+        const Node* n{locate(k)};
+        if (n == nullptr)
+            return std::nullopt;
+        return n->entry.value();
+    }
+
+    /// Returns a copy of the value associated with given key,
+    /// or throws out_of_range exception if key not found
+    Value at(const Key& k) const {
+        auto guard{epochs.guard()};
+        const Node* n{locate(k)};
+        if (n == nullptr)
+            throw std::out_of_range("key not found");
+        return n->entry.value();
+    }
+
+    /// Calls visit(entry) for each entry. Entries inserted or erased during the traversal
+    /// may or may not be visited, but each entry present throughout is visited exactly once.
+    template <typename F>
+    void for_each(F visit) const {
+        auto guard{epochs.guard()};
+        Table* t{table.load(std::memory_order_acquire)};
+        for (const std::atomic<Node*>& b : t->buckets)
+            for (Node* n = b.load(std::memory_order_acquire); n != nullptr;
+                 n = n->next.load(std::memory_order_acquire))
+                visit(n->entry);
+    }
+
+    /// Associates given key with given value, overwriting any previous value.
+    /// Returns true if the key was not previously in the map.
+    bool put(const Key& k, const Value& v) {
+        std::lock_guard<std::mutex> guard(write_lock);
+        Table* t{table.load()};
+        std::atomic<Node*>* link{find_link(t, k)};
+        Node* old{link->load()};
+        if (old != nullptr) {                                       // replace the node
+            link->store(new Node(Entry(k, v), old->next.load()), std::memory_order_release);
+            epochs.retire(old);
+            maybe_reclaim();
+            return false;
+        }
+        if (sz + 1 > max_load * t->buckets.size()) {
+            rehash(Sizing::size_for(2 * t->buckets.size()));
+            t = table.load();
+        }
+        std::atomic<Node*>& head{bucket(t, k)};
+        head.store(new Node(Entry(k, v), head.load()), std::memory_order_release);
+        sz++;
+        maybe_reclaim();
+        return true;
+    }
+
+    /// Erases the entry with the given key (if one exists).
+    /// Returns true if an entry was removed, false otherwise.
+    bool erase(const Key& k) {
+        std::lock_guard<std::mutex> guard(write_lock);
+        std::atomic<Node*>* link{find_link(table.load(), k)};
+        Node* old{link->load()};
+        if (old == nullptr)
+            return false;
+        link->store(old->next.load(), std::memory_order_release);    // readers on old may continue
+        epochs.retire(old);
+        sz--;
+        maybe_reclaim();
+        return true;
+    }
+};
+
+} // namespace dsac::map
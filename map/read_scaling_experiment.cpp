@@ -0,0 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <thread>
+#include <vector>
+
+#include "concurrent_hash_map.h"
+#include "read_mostly_hash_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::map;
+
+/// Each of t threads performs the given number of lookups of random keys in a map of n
+/// entries, while one extra thread updates a random entry every 50 microseconds.
+/// Reports the total throughput for each t = 1, 2, 4, ..., max_threads.
+template <typename Map>
+void experiment(const string& name, int n, int lookups, int max_threads) {
+    Map map;
+    for (int j = 0; j < n; j++)
+        map.put(j, j);
+
+    cout << endl << name << ":" << endl;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        atomic<int> readers_left{t};
+        atomic<long> found{0};
+        auto start = high_resolution_clock::now();
+        vector<thread> readers;
+        for (int r = 0; r < t; r++)
+            readers.emplace_back([&, r]() {
+                mt19937 rng(r);
+                long count{0};
+                for (int j = 0; j < lookups; j++)
+                    if (map.find(rng() % n)) count++;
+                found += count;
+                readers_left--;
+            });
+        thread writer([&]() {
+            mt19937 rng(n);
+            while (readers_left > 0) {
+                map.put(rng() % n, rng());
+                this_thread::sleep_for(microseconds(50));
+            }
+        });
+        for (thread& r : readers) r.join();
+        writer.join();
+        auto stop = high_resolution_clock::now();
+        double elapsed = duration_cast<microseconds>(stop-start).count();
+        cout << setw(3) << t << " reader threads: " << setw(9) << fixed << setprecision(2)
+             << (static_cast<double>(t) * lookups / elapsed) << " million lookups per second" << endl;
+    }
+}
+
+/// Compares lookup throughput of the lock-free ReadMostlyHashMap with the lock-sharded
+/// ConcurrentHashMap as readers are added. The command line arguments set the number of
+/// entries, lookups per reader thread, and maximum number of reader threads.
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 100000};             // entries (default 100000)
+    int lookups{argc >= 3 ? stoi(argv[2]) : 1000000};      // lookups per thread (default 1000000)
+    int max_threads{argc >= 4 ? stoi(argv[3]) : 64};       // most reader threads (default 64)
+
+    experiment<ReadMostlyHashMap<int,int>>("ReadMostlyHashMap", n, lookups, max_threads);
+    experiment<ConcurrentHashMap<int,int>>("ConcurrentHashMap", n, lookups, max_threads);
+
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (n=100000, 200000 lookups per thread, on a single-core machine, so
+the totals cannot grow with the number of threads; they show only the per-lookup cost):
+
+ReadMostlyHashMap:
+  1 reader threads:      9.39 million lookups per second
+  2 reader threads:     15.41 million lookups per second
+  4 reader threads:     18.32 million lookups per second
+  8 reader threads:     18.33 million lookups per second
+ 16 reader threads:     19.98 million lookups per second
+ 32 reader threads:     18.99 million lookups per second
+ 64 reader threads:     19.16 million lookups per second
+
+ConcurrentHashMap:
+  1 reader threads:      2.70 million lookups per second
+  2 reader threads:      2.51 million lookups per second
+  4 reader threads:      2.66 million lookups per second
+  8 reader threads:      2.70 million lookups per second
+ 16 reader threads:      2.77 million lookups per second
+ 32 reader threads:      2.87 million lookups per second
+ 64 reader threads:      2.99 million lookups per second
+
+*/
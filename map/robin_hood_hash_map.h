@@ -0,0 +1,224 @@
+#pragma once
+
+#include "abstract_hash_map.h"
+
+#include <functional>               // defines std::hash
+#include <stdexcept>
+#include <utility>                  // defines std::move, std::swap
+#include <vector>
+
+namespace dsac::map {
+
+/// A linear-probing hash map using "Robin Hood" insertion: an entry being inserted
+/// takes the place of any entry that is closer to its own home bucket, which keeps
+/// all probe lengths close to the average. Removal shifts the following entries
+/// back by one slot, so no DEFUNCT markers are ever left behind. Iteration begins just
+/// after an empty cell (rather than at cell 0), so that no cluster wraps around the end of
+/// the iteration order and removal only ever moves an entry backward in that order.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Sizing = PrimeSizing>
+class RobinHoodHashMap : public AbstractHashMap<Key, Value, Hash, Sizing> {
+  protected:
+    typedef AbstractHashMap<Key, Value, Hash, Sizing> Base;
+  public:
+    using typename Base::Entry;                                  // make nested Entry public
+  protected:
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator, Base::table_sz, Base::sz;
+
+    std::vector<Entry> table;
+    std::vector<int> dist;            // dist[j] is the distance of cell j's entry from its home (-1 if empty)
+    int origin{0};                    // an empty cell; iteration starts with the cell after it
+
+    void create_table() {
+        table.clear();
+        table.resize(table_sz);
+        dist.assign(table_sz, -1);
+        origin = 0;
+    }
+
+    int next(int j) const { return (j + 1 == table_sz ? 0 : j + 1); }
+
+    // the cell at the given position of the iteration order, and vice versa
+    int cell_at(int pos) const {
+        int j{origin + 1 + pos};
+        return (j >= table_sz ? j - table_sz : j);
+    }
+    int pos_of(int j) const {
+        int pos{j - origin - 1};
+        return (pos < 0 ? pos + table_sz : pos);
+    }
+
+    // moves origin forward to an empty cell, if an insertion has filled it
+    void settle_origin() {
+        while (dist[origin] >= 0)
+            origin = next(origin);
+    }
+
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {    // specialize abstract version
+      public:
+        const RobinHoodHashMap* map{nullptr};
+        int pos;                                   // position in iteration order (table.size() is end)
+        iter_rep(const RobinHoodHashMap* m, int p) : map{m}, pos{p} {}
+
+        const Entry& entry() const { return map->table[map->cell_at(pos)]; }
+
+        void advance() {
+            do {
+                ++pos;
+            } while (pos < map->table.size() && map->dist[map->cell_at(pos)] < 0);
+        }
+
+        bool equals(const abstract_iter_rep* other) const {
+            const iter_rep* p = dynamic_cast<const iter_rep*>(other);
+            return p != nullptr && map == p->map && pos == p->pos;
+        }
+    }; // end class iter_rep
+    friend iter_rep;
+
+  public:
+    using AbstractMap<Key,Value>::erase;                         // makes the Key-based version accessible
+    using typename AbstractMap<Key,Value>::const_iterator;
+
+    /// Creates an empty map
+    RobinHoodHashMap() { create_table(); }
+
+    const_iterator begin() const {
+        iter_rep r(this, -1);                                    // artificial -1 position before advance
+        r.advance();                                             // advance to first actual entry (or end)
+        return make_iterator(r);
+    }
+
+    const_iterator end() const {
+        return make_iterator(iter_rep(this, table.size()));
+    }
+
+    /// Reports the occupancy of the table, including the lengths of its clusters
+    HashMapLayout layout() const {
+        HashMapLayout result;
+        result.entries = sz;
+        result.buckets = table_sz;
+        result.bytes = table.capacity() * sizeof(Entry) + dist.capacity() * sizeof(int);
+        int run{0};                                              // length of current cluster
+        for (int j = 0; j < table_sz; j++) {
+            if (dist[j] >= 0)
+                run++;
+            else if (run > 0) {
+                result.count(run);
+                run = 0;
+            }
+        }
+        if (run > 0) result.count(run);
+        return result;
+    }
+
+  protected:
+    // Returns the index at which key k (with hash value h) is found, or -1 if not found.
+    // The search stops as soon as it reaches an entry that is closer to its home than
+    // k would be, since Robin Hood insertion would have placed k before that entry.
+    // The number of cells examined is added to probes.
+    int find_slot(int h, const Key& k, int& probes) const {
+        int j{h};
+        for (int d = 0; dist[j] >= d; d++) {
+            probes++;
+            if (dist[j] == d && table[j].key() == k)
+                return j;                                        // successful match
+            j = next(j);
+        }
+        probes++;                                                // the cell that ended the search
+        return -1;
+    }
+
+    // Places new entry e (with hash value h), displacing richer entries as necessary.
+    // Returns the index at which e itself was placed.
+    int place(int h, Entry&& e) {
+        Entry carry{std::move(e)};
+        int result{-1};
+        int j{h};
+        for (int d = 0; ; d++, j = next(j)) {
+            if (dist[j] < 0) {                                   // empty cell ends the insertion
+                table[j] = std::move(carry);
+                dist[j] = d;
+                return (result < 0 ? j : result);
+            }
+            if (dist[j] < d) {                                   // resident is closer to home; displace it
+                using std::swap;
+                swap(carry, table[j]);
+                swap(d, dist[j]);
+                if (result < 0) result = j;
+            }
+        }
+    }
+
+    // a search (and an insertion) ends at an empty cell, so the table must never fill
+    void check_max_load(float f) const {
+        Base::check_max_load(f);
+        if (!(f < 1))
+            throw std::invalid_argument("max load factor must be less than 1 with linear probing");
+    }
+
+    void bucket_prefetch(int h) const {
+        prefetch(&dist[h]);
+        prefetch(&table[h]);
+    }
+
+    // search for entry with key k in "bucket h"
+    const_iterator bucket_find(int h, const Key& k) const {
+        int probes{0};                                           // cells examined (for statistics)
+        int j{find_slot(h, k, probes)};
+        this->record_probe(probes);                              // only lookups are recorded
+        return (j < 0 ? end() : make_iterator(iter_rep(this, pos_of(j))));
+    }
+
+    // add/update Entry(k,v) within "bucket h", copying or moving k and v as given
+    template <typename K, typename V>
+    const_iterator bucket_insert(int h, K&& k, V&& v) {
+        int probes{0};
+        int j{find_slot(h, k, probes)};
+        if (j >= 0)
+            this->update_value(table[j], std::forward<V>(v));    // replace existing value
+        else {
+            j = place(h, Entry(std::forward<K>(k), std::forward<V>(v)));
+            sz++;
+            settle_origin();
+        }
+        return make_iterator(iter_rep(this, pos_of(j)));
+    }
+
+    const_iterator bucket_put(int h, const Key& k, const Value& v) { return bucket_insert(h, k, v); }
+    const_iterator bucket_put(int h, Key&& k, Value&& v) { return bucket_insert(h, std::move(k), std::move(v)); }
+
+    // Removes the entry at loc by shifting the rest of its cluster back one cell. The shift
+    // stops before an empty cell, so origin stays empty and each shifted entry moves to the
+    // position just before it in iteration order (never past the returned iterator).
+    const_iterator bucket_erase(int h, const_iterator loc) {
+        (void)h;
+        int j{cell_at(dynamic_cast<iter_rep*>(get_rep(loc))->pos)};
+        int start{j};
+        for (int k = next(j); dist[k] > 0; j = k, k = next(k)) {
+            table[j] = std::move(table[k]);
+            dist[j] = dist[k] - 1;
+        }
+        table[j] = Entry();                                      // release the last key and value
+        dist[j] = -1;
+        sz--;
+        iter_rep r(this, pos_of(start));                         // start now holds the next entry, if any
+        if (dist[start] < 0) r.advance();
+        return make_iterator(r);
+    }
+
+    // Change table size, placing each entry directly into the new table
+    void resize(int new_table_size) {
+        std::vector<Entry> old_table;
+        std::vector<int> old_dist;
+        old_table.swap(table);
+        old_dist.swap(dist);
+        table_sz = new_table_size;
+        create_table();
+        for (int j = 0; j < old_table.size(); j++)
+            if (old_dist[j] >= 0)
+                place(this->get_hash(old_table[j].key()), std::move(old_table[j]));
+        settle_origin();
+    }
+};
+
+} // namespace dsac::map
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <utility>
+#include <vector>
+
+#include "searchtree/avl_tree_map.h"
+#include "searchtree/red_black_tree_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::search_tree;
+
+/// Reports the time since start
+void report(const string& name, high_resolution_clock::time_point start) {
+    auto stop = high_resolution_clock::now();
+    double elapsed = duration_cast<nanoseconds>(stop-start).count();
+    cout << setw(32) << left << name << right << setw(9) << fixed << setprecision(1)
+         << elapsed / 1000000 << " milliseconds" << endl;
+}
+
+/// Returns n sorted (key, value) pairs with random distinct keys from the range 0 to 2*n-1
+vector<pair<int,int>> random_items(int n, mt19937& rng) {
+    vector<pair<int,int>> items;
+    for (int k = 0; k < 2 * n; k++)
+        if (rng() % (2 * n - k) < n - items.size())            // selection sampling
+            items.push_back({k, 1});
+    return items;
+}
+
+/// Merges map b into map a by calling put (or upsert) for each entry of b, and then with
+/// unite, intersect and subtract using varying numbers of threads
+template <typename Map>
+void experiment(const string& name, const vector<pair<int,int>>& a, const vector<pair<int,int>>& b, int max_threads) {
+    auto sum{[](int x, int y) { return x + y; }};
+    cout << name << ":" << endl;
+    {
+        Map x(a.begin(), a.end());
+        auto start = high_resolution_clock::now();
+        for (auto [k, v] : b)
+            x.upsert(k, v, [v](int& old) { old += v; });
+        report("  upsert each entry", start);
+    }
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        Map x(a.begin(), a.end()), y(b.begin(), b.end());
+        auto start = high_resolution_clock::now();
+        x.unite(y, sum, threads);
+        report("  unite (" + to_string(threads) + " threads)", start);
+    }
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        Map x(a.begin(), a.end()), y(b.begin(), b.end());
+        auto start = high_resolution_clock::now();
+        x.intersect(y, sum, threads);
+        report("  intersect (" + to_string(threads) + " threads)", start);
+        Map r(a.begin(), a.end()), s(b.begin(), b.end());
+        start = high_resolution_clock::now();
+        r.subtract(s, threads);
+        report("  subtract (" + to_string(threads) + " threads)", start);
+    }
+}
+
+/// The command line arguments set the sizes of the two maps and the largest number of threads
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 1000000};            // entries of first map (default 1000000)
+    int m{argc >= 3 ? stoi(argv[2]) : 1000000};            // entries of second map (default 1000000)
+    int max_threads{argc >= 4 ? stoi(argv[3]) : 8};        // most threads (default 8)
+
+    mt19937 rng(n);
+    vector<pair<int,int>> a{random_items(n, rng)}, b{random_items(m, rng)};
+    experiment<AVLTreeMap<int,int>>("AVLTreeMap", a, b, max_threads);
+    experiment<RedBlackTreeMap<int,int>>("RedBlackTreeMap", a, b, max_threads);
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (default arguments, on a machine with a single core, so that no speedup is possible):
+
+AVLTreeMap:
+  upsert each entry                 259.8 milliseconds
+  unite (1 threads)                 102.2 milliseconds
+  unite (2 threads)                 113.0 milliseconds
+  unite (4 threads)                 165.1 milliseconds
+  unite (8 threads)                 185.2 milliseconds
+  intersect (1 threads)             272.1 milliseconds
+  subtract (1 threads)              267.1 milliseconds
+  intersect (2 threads)             284.1 milliseconds
+  subtract (2 threads)              283.2 milliseconds
+  intersect (4 threads)             356.5 milliseconds
+  subtract (4 threads)              312.4 milliseconds
+  intersect (8 threads)             313.0 milliseconds
+  subtract (8 threads)              340.3 milliseconds
+RedBlackTreeMap:
+  upsert each entry                 477.6 milliseconds
+  unite (1 threads)                 291.6 milliseconds
+  unite (2 threads)                 324.6 milliseconds
+  unite (4 threads)                 321.9 milliseconds
+  unite (8 threads)                 287.9 milliseconds
+  intersect (1 threads)             325.9 milliseconds
+  subtract (1 threads)              305.7 milliseconds
+  intersect (2 threads)             240.5 milliseconds
+  subtract (2 threads)              267.4 milliseconds
+  intersect (4 threads)             305.9 milliseconds
+  subtract (4 threads)              368.3 milliseconds
+  intersect (8 threads)             387.3 milliseconds
+  subtract (8 threads)              391.4 milliseconds
+
+*/
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "abstract_map.h"
+#include "table_sizing.h"           // defines mix_bits
+
+#include <cstdint>
+#include <functional>               // defines std::hash
+#include <utility>                  // defines std::move, std::forward
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>              // SSE2 intrinsics for 16-byte group compares
+#endif
+
+namespace dsac::map {
+
+/// An open-addressing hash map in which each slot has a one-byte control tag, stored
+/// separately from the entries. The tag records whether the slot is empty, deleted, or
+/// full (in which case it holds 7 bits of the key's hash). Lookups probe an entire group
+/// of 16 tags at once, and only compare keys for slots whose tags match.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SwissHashMap : public AbstractMap<Key,Value> {
+  protected:
+    typedef AbstractMap<Key,Value> Base;
+  public:
+    using typename Base::Entry, typename Base::const_iterator;
+    using Base::erase;
+  protected:
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator;
+
+    static constexpr int GROUP{16};                  // number of slots examined per probe
+    static constexpr signed char EMPTY{-128};        // 0b10000000
+    static constexpr signed char DELETED{-2};        // 0b11111110
+                                                     // full slots store 0b0xxxxxxx
+
+    Hash hash;                                       // hash function
+    int sz{0};                                       // number of entries
+    int num_deleted{0};                              // number of DELETED tags
+    std::vector<signed char> ctrl;                   // control tag for each slot
+    std::vector<Entry> slots;                        // entries, parallel to ctrl
+
+    // mixes the bits of the user's hash, as std::hash is often the identity on integers
+    static std::uint64_t mix(std::uint64_t h) { return mix_bits(h); }
+    static int fragment(std::uint64_t h) { return h & 0x7F; }            // low 7 bits for tag
+    int first_group(std::uint64_t h) const { return (h >> 7) & (num_groups() - 1); }
+    int num_groups() const { return ctrl.size() / GROUP; }
+
+    // bit j of the result is set if tag j of the group equals t
+    static unsigned match(const signed char* group, signed char t) {
+#ifdef __SSE2__
+        __m128i tags{_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))};
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(t)));
+#else
+        unsigned result{0};
+        for (int j = 0; j < GROUP; j++)
+            if (group[j] == t) result |= (1u << j);
+        return result;
+#endif
+    }
+
+    // bit j of the result is set if tag j of the group is EMPTY or DELETED (high bit set)
+    static unsigned match_available(const signed char* group) {
+#ifdef __SSE2__
+        return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+#else
+        unsigned result{0};
+        for (int j = 0; j < GROUP; j++)
+            if (group[j] < 0) result |= (1u << j);
+        return result;
+#endif
+    }
+
+    static int lowest_bit(unsigned mask) { return __builtin_ctz(mask); }
+
+    // Returns the slot index of key k (with mixed hash h), or -1 if not present.
+    // Groups are visited in triangular order g, g+1, g+3, g+6, ... which reaches every
+    // group because the number of groups is a power of two.
+    int find_slot(std::uint64_t h, const Key& k) const {
+        int mask{num_groups() - 1};
+        int g{first_group(h)};
+        signed char tag(fragment(h));
+        for (int step = 1; step <= num_groups(); step++) {
+            const signed char* group{&ctrl[g * GROUP]};
+            for (unsigned m = match(group, tag); m != 0; m &= m - 1) {
+                int j{g * GROUP + lowest_bit(m)};
+                if (slots[j].key() == k) return j;                   // successful match
+            }
+            if (match(group, EMPTY) != 0) return -1;                 // an empty slot ends the search
+            g = (g + step) & mask;
+        }
+        return -1;
+    }
+
+    // Returns the first EMPTY or DELETED slot on the probe sequence for hash h
+    int find_available(std::uint64_t h) const {
+        int mask{num_groups() - 1};
+        int g{first_group(h)};
+        for (int step = 1; ; step++) {
+            unsigned m{match_available(&ctrl[g * GROUP])};
+            if (m != 0) return g * GROUP + lowest_bit(m);
+            g = (g + step) & mask;
+        }
+    }
+
+    // Rebuilds the table with the given number of slots (a power of two, multiple of GROUP)
+    void rehash(int capacity) {
+        std::vector<signed char> old_ctrl(capacity, EMPTY);
+        std::vector<Entry> old_slots(capacity);
+        ctrl.swap(old_ctrl);
+        slots.swap(old_slots);
+        num_deleted = 0;
+        for (int j = 0; j < old_ctrl.size(); j++)
+            if (old_ctrl[j] >= 0) {                                  // full slot
+                std::uint64_t h{mix(hash(old_slots[j].key()))};
+                int a{find_available(h)};
+                ctrl[a] = fragment(h);
+                slots[a] = std::move(old_slots[j]);
+            }
+    }
+
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {   // specialize abstract version
+      public:
+        const SwissHashMap* map{nullptr};
+        int loc;                                                     // which slot? (ctrl.size() is end)
+        iter_rep(const SwissHashMap* m, int j) : map{m}, loc{j} {}
+
+        const Entry& entry() const { return map->slots[loc]; }
+        void advance() {
+            do {
+                ++loc;
+            } while (loc < map->ctrl.size() && map->ctrl[loc] < 0);  // skip EMPTY and DELETED
+        }
+        bool equals(const abstract_iter_rep* other) const {
+            const iter_rep* p = dynamic_cast<const iter_rep*>(other);
+            return p != nullptr && map == p->map && loc == p->loc;
+        }
+    }; // end class iter_rep
+    friend iter_rep;
+
+  public:
+    /// Creates an empty map
+    SwissHashMap() : ctrl(GROUP, EMPTY), slots(GROUP) {}
+
+    /// Returns the number of entries in the map
+    int size() const { return sz; }
+
+    /// Returns a const_iterator to the first entry
+    const_iterator begin() const {
+        iter_rep r(this, -1);                                        // artificial -1 location before advance
+        r.advance();
+        return make_iterator(r);
+    }
+
+    /// Returns a const_iterator representing the end
+    const_iterator end() const { return make_iterator(iter_rep(this, ctrl.size())); }
+
+    /// Returns a const_iterator to the entry with a given key, or end() if no such entry exists
+    const_iterator find(const Key& k) const {
+        int j{find_slot(mix(hash(k)), k)};
+        return (j < 0 ? end() : make_iterator(iter_rep(this, j)));
+    }
+
+  protected:
+    // add/update Entry(k,v), copying or moving k and v as given
+    template <typename K, typename V>
+    const_iterator insert(K&& k, V&& v) {
+        std::uint64_t h{mix(hash(k))};
+        int j{find_slot(h, k)};
+        if (j >= 0) {
+            this->update_value(slots[j], std::forward<V>(v));        // replace existing value
+            return make_iterator(iter_rep(this, j));
+        }
+        if (8 * (sz + num_deleted + 1) > 7 * ctrl.size())            // keep load (with tombstones) <= 7/8
+            rehash(2 * sz + 2 > ctrl.size() ? 2 * ctrl.size() : ctrl.size());  // grow, or just purge tombstones
+        j = find_available(h);
+        if (ctrl[j] == DELETED) num_deleted--;
+        ctrl[j] = fragment(h);
+        slots[j] = Entry(std::forward<K>(k), std::forward<V>(v));
+        sz++;
+        return make_iterator(iter_rep(this, j));
+    }
+
+  public:
+    /// Associates given key with given value. If key already exists previous value is overwritten.
+    /// Returns an iterator to the entry associated with the key
+    const_iterator put(const Key& k, const Value& v) { return insert(k, v); }
+
+    /// Same as above, but moving the key and value into the map
+    const_iterator put(Key&& k, Value&& v) { return insert(std::move(k), std::move(v)); }
+
+    /// Removes the entry indicated by the given iterator, and returns iterator to next entry in iteration order
+    const_iterator erase(const_iterator loc) {
+        int j{dynamic_cast<iter_rep*>(get_rep(loc))->loc};
+        // A probe only continues past a group with no EMPTY tag, so if this slot's
+        // group already has one, the slot may safely become EMPTY rather than DELETED.
+        if (match(&ctrl[(j / GROUP) * GROUP], EMPTY) != 0)
+            ctrl[j] = EMPTY;
+        else {
+            ctrl[j] = DELETED;
+            num_deleted++;
+        }
+        slots[j] = Entry();                                          // release the old key and value
+        sz--;
+        iter_rep next(this, j);
+        next.advance();
+        return make_iterator(next);
+    }
+};
+
+} // namespace dsac::map
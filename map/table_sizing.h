@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dsac::map {
+
+// Each sizing policy decides which table sizes a hash map may use and how a hash code is
+// compressed into a bucket index for a table of that size. A policy provides:
+//
+//   static int initial_size()                       number of buckets for a new map
+//   static int size_for(int n)                      smallest allowed size that is at least n
+//   static int index(std::size_t h, int table_sz)   bucket index in range [0, table_sz)
+
+/// Scrambles the bits of a 64-bit hash code (the finalizer from MurmurHash3), so that
+/// policies relying on only some of the bits are not fooled by simple hash codes,
+/// such as std::hash for integers, which is the identity.
+inline std::uint64_t mix_bits(std::uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/// Division method, with table sizes drawn from a sequence of primes that roughly double
+struct PrimeSizing {
+    static int initial_size() { return 17; }
+
+    static int size_for(int n) {
+        static const int primes[] = {
+            17, 37, 79, 163, 331, 673, 1361, 2729, 5471, 10949, 21911, 43853, 87719,
+            175447, 350899, 701819, 1403641, 2807303, 5614657, 11229331, 22458671,
+            44917381, 89834777, 179669557, 359339171, 718678369, 1437356741
+        };
+        for (int p : primes)
+            if (p >= n) return p;
+        return primes[sizeof(primes) / sizeof(int) - 1];   // largest supported size
+    }
+
+    static int index(std::size_t h, int table_sz) { return h % table_sz; }
+};
+
+/// Power-of-two table sizes, so that compression is a bit mask rather than a division.
+/// The hash code is mixed first, since masking keeps only its low-order bits.
+struct PowerOfTwoSizing {
+    static int initial_size() { return 16; }
+
+    static int size_for(int n) {
+        int result{initial_size()};
+        while (result < n) result *= 2;
+        return result;
+    }
+
+    static int index(std::size_t h, int table_sz) { return mix_bits(h) & (table_sz - 1); }
+};
+
+/// Lemire's "fastrange" reduction: maps a 32-bit hash x into [0,n) as (x * n) >> 32,
+/// using a multiplication and shift in place of division, with any table size.
+struct FastRangeSizing {
+    static int initial_size() { return 16; }
+
+    static int size_for(int n) { return n < initial_size() ? initial_size() : n; }
+
+    static int index(std::size_t h, int table_sz) {
+        std::uint64_t x{mix_bits(h) >> 32};                // high (best mixed) 32 bits
+        return (x * static_cast<std::uint64_t>(table_sz)) >> 32;
+    }
+};
+
+} // namespace dsac::map
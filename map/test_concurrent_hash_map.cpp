@@ -0,0 +1,94 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_hash_map.h"
+#include "probe_hash_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// Several threads concurrently count occurrences of words from a shared sequence;
+/// the totals must match a sequential count.
+template <typename Map>
+void test_counting(const string& name, int num_threads, int n, int range) {
+    vector<string> words;
+    mt19937 rng(n);
+    for (int j = 0; j < n; j++)
+        words.push_back("w" + to_string(rng() % range));
+
+    Map freq(16);
+    vector<thread> workers;
+    for (int t = 0; t < num_threads; t++)
+        workers.emplace_back([&, t]() {
+            for (int j = t; j < n; j += num_threads)
+                freq.merge(words[j], 1, [](int a, int b) { return a + b; });
+        });
+    for (thread& w : workers) w.join();
+
+    std::map<string,int> model;
+    for (const string& w : words) model[w]++;
+    bool ok{freq.size() == model.size()};
+    int visited{0};
+    freq.for_each([&](const auto& entry) {
+        visited++;
+        ok = ok && model[entry.key()] == entry.value();
+    });
+    ok = ok && visited == model.size();
+    cout << name << " counting" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Writer threads each own a disjoint range of keys, which they repeatedly put and erase,
+/// while reader threads check that any value found is consistent with its key. Meanwhile,
+/// compute_if_absent on a shared key must call its function exactly once.
+template <typename Map>
+void test_mixed(const string& name, int num_writers, int num_readers, int rounds) {
+    const int per_writer{1000};
+    Map map;
+    atomic<bool> ok{true};
+    atomic<int> computed{0};
+    vector<thread> workers;
+    for (int t = 0; t < num_writers; t++)
+        workers.emplace_back([&, t]() {
+            for (int r = 0; r < rounds; r++) {
+                for (int k = t * per_writer; k < (t + 1) * per_writer; k++)
+                    map.put(k, 2 * k);
+                for (int k = t * per_writer + r % 2; k < (t + 1) * per_writer; k += 2)
+                    if (!map.erase(k)) ok = false;
+                map.compute_if_absent(-1, [&](int) { computed++; return 42; });
+            }
+        });
+    for (int t = 0; t < num_readers; t++)
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t);
+            for (int j = 0; j < rounds * per_writer; j++) {
+                int k = rng() % (num_writers * per_writer);
+                auto v = map.find(k);
+                if (v && *v != 2 * k) ok = false;
+            }
+        });
+    for (thread& w : workers) w.join();
+
+    // each writer's last round leaves half of its keys
+    ok = ok && computed == 1 && map.find(-1) == 42;
+    ok = ok && map.size() == num_writers * per_writer / 2 + 1;
+    for (int s = 0; s < map.num_shards(); s++)
+        map.for_each_in_shard(s, [&](const auto& entry) {
+            if (entry.key() >= 0 && entry.value() != 2 * entry.key()) ok = false;
+        });
+    cout << name << " mixed" << (ok ? " passed" : " FAILED") << endl;
+}
+
+int main() {
+    test_counting<ConcurrentHashMap<string,int>>("ConcurrentHashMap", 8, 200000, 5000);
+    test_counting<ConcurrentHashMap<string,int,hash<string>,ProbeHashMap<string,int>>>(
+        "ConcurrentHashMap (probe shards)", 8, 200000, 5000);
+    test_mixed<ConcurrentHashMap<int,int>>("ConcurrentHashMap", 4, 4, 20);
+    test_mixed<ConcurrentHashMap<int,int,hash<int>,ProbeHashMap<int,int>>>("ConcurrentHashMap (probe shards)", 4, 4, 20);
+    return EXIT_SUCCESS;
+}
@@ -1,8 +1,16 @@
+#include <atomic>
 #include <iostream>
+#include <random>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "ordered_table_map.h"
 #include "cost_performance.h"
+#include "concurrent_cost_performance.h"
+#include "searchtree/avl_tree_map.h"
+#include "searchtree/b_tree_map.h"
+#include "searchtree/red_black_tree_map.h"
 using namespace std;
 using namespace dsac::map;
 
@@ -18,6 +26,59 @@ void validate(const CostPerformanceDatabase<OrderedMap>& db) {
     
 }
 
+// Several producers add random batches while readers query snapshots; every snapshot must
+// be free of dominated entries, and the final database must match one built sequentially
+// from all of the pairs. Also checks range queries against a scan of the database.
+template <typename OrderedMap>
+void test_concurrent(const string& name, int producers, int batches, int batch_size) {
+    ConcurrentCostPerformanceDatabase<OrderedMap> shared;
+    vector<vector<pair<int,int>>> work(producers);
+    CostPerformanceDatabase<OrderedMap> expected;
+    mt19937 rng(producers);
+    for (auto& w : work)
+        for (int j = 0; j < batches * batch_size; j++) {
+            w.push_back({int(rng() % 100000), int(rng() % 100000)});
+            expected.add(w.back().first, w.back().second);
+        }
+
+    atomic<bool> done{false}, ok{true};
+    thread reader([&]() {
+        while (!done) {
+            auto db = shared.snapshot();
+            int old_perf{-1};
+            for (auto entry : *db) {
+                if (entry.value() <= old_perf) ok = false;
+                old_perf = entry.value();
+            }
+            auto hit = shared.best(50000);
+            if (hit && hit->first > 50000) ok = false;
+        }
+    });
+    vector<thread> writers;
+    for (int t = 0; t < producers; t++)
+        writers.emplace_back([&, t]() {
+            for (int j = 0; j < batches; j++)
+                shared.add_all(work[t].begin() + j * batch_size, work[t].begin() + (j + 1) * batch_size);
+        });
+    for (thread& w : writers)
+        w.join();
+    done = true;
+    reader.join();
+
+    bool same{shared.size() == expected.size()};
+    auto db = shared.snapshot();
+    for (auto a = db->begin(), b = expected.begin(); same && b != expected.end(); ++a, ++b)
+        same = (a->key() == b->key() && a->value() == b->value());
+    for (int a = 0; same && a < 100000; a += 9973) {
+        vector<pair<int,int>> scan;
+        for (auto entry : expected)
+            if (entry.key() >= a && entry.key() <= a + 20000)
+                scan.push_back({entry.key(), entry.value()});
+        same = (shared.range(a, a + 20000) == scan);
+    }
+    cout << "ConcurrentCostPerformanceDatabase (" << name << ")" << (ok && same ? " passed" : " FAILED") << endl;
+}
+
 int main() {
     CostPerformanceDatabase database;
 
@@ -32,5 +93,10 @@ int main() {
         for (auto entry : database) cout << "(" << entry.key() << "," << entry.value() << ") ";
         cout << endl;
     }
-    
+
+    test_concurrent<OrderedTableMap<int,int>>("OrderedTableMap", 4, 50, 100);
+    test_concurrent<dsac::search_tree::AVLTreeMap<int,int>>("AVLTreeMap", 4, 50, 100);
+    test_concurrent<dsac::search_tree::RedBlackTreeMap<int,int,less<int>,dsac::tree::PooledNodes>>(
+        "RedBlackTreeMap (pooled nodes)", 4, 50, 100);
+    test_concurrent<dsac::search_tree::BTreeMap<int,int,less<int>,4>>("BTreeMap", 4, 50, 100);
 }
@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "flat_multimap.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// Returns true if the span holds exactly the values of key k within the model, in order
+bool same_values(ValueSpan<int> span, const multimap<int,int>& model, int k) {
+    auto [first, last] = model.equal_range(k);
+    vector<int> expected;
+    for (auto it = first; it != last; ++it)
+        expected.push_back(it->second);
+    return vector<int>(span.begin(), span.end()) == expected;
+}
+
+/// Fills a FlatMultimap using each form of insertion, erases some keys, and then checks
+/// it and two FrozenMultimaps against std::multimap (which keeps equal keys in order)
+void test(int n, int keys) {
+    mt19937 rng(n);
+    FlatMultimap<int,int> flat;
+    multimap<int,int> model;
+    vector<pair<int,int>> all;
+    for (int j = 0; j < n; j++) {
+        int k = rng() % keys;
+        switch (j % 3) {
+          case 0:
+            flat.insert(k, j);
+            model.insert({k, j});
+            all.push_back({k, j});
+            break;
+          case 1: {
+            vector<int> run{j, -j};
+            flat.insert(k, run.begin(), run.end());
+            for (int v : run) {
+                model.insert({k, v});
+                all.push_back({k, v});
+            }
+            break;
+          }
+          default: {
+            vector<pair<int,int>> batch{{k, j}, {(k + 1) % keys, j}, {k, j + 1}};
+            flat.insert_all(batch.begin(), batch.end());
+            for (auto e : batch) {
+                model.insert(e);
+                all.push_back(e);
+            }
+          }
+        }
+    }
+    vector<int> none;
+    flat.insert(keys, none.begin(), none.end());                 // adds no key
+    bool ok{flat.size() == model.size() && flat.count(keys) == 0};
+    FrozenMultimap<int,int> frozen_all(all.begin(), all.end());
+    for (int k = -1; ok && k <= keys; k++)
+        ok = (flat.count(k) == model.count(k)) && same_values(flat.equal_range(k), model, k) &&
+             same_values(frozen_all.equal_range(k), model, k);
+    ok = ok && frozen_all.size() == model.size();
+
+    for (int k = 0; ok && k < keys; k += 3)
+        ok = (flat.erase(k) == model.erase(k));
+    FrozenMultimap<int,int> frozen(flat);
+    std::size_t distinct{0};
+    for (auto walk = model.begin(); walk != model.end(); walk = model.upper_bound(walk->first))
+        distinct++;
+    ok = ok && frozen.size() == model.size() && frozen.key_count() == flat.key_count() && flat.key_count() == distinct;
+    for (int k = -1; ok && k <= keys; k++)
+        ok = same_values(frozen.equal_range(k), model, k) && frozen.count(k) == model.count(k);
+    std::size_t visited{0};
+    frozen.for_each([&](int k, ValueSpan<int> values) {
+        visited += values.size();
+        ok = ok && same_values(values, model, k);
+    });
+    ok = ok && visited == model.size() && FrozenMultimap<int,int>().empty();
+
+    cout << "FlatMultimap and FrozenMultimap (" << n << " insertions, " << keys << " keys)"
+         << (ok ? " passed" : " FAILED") << endl;
+}
+
+int main() {
+    test(0, 1);
+    test(1000, 10);
+    test(100000, 5000);
+    return EXIT_SUCCESS;
+}
@@ -1,13 +1,116 @@
 #include "hash_code.h"
 
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
 using namespace std;
+using namespace std::chrono;
 using namespace dsac::map;
 
-int main() {
+/// Reports how well the hash function h spreads the given (distinct) words: the number of
+/// full 32-bit hash collisions, the words sharing a bucket in a power-of-two table of m
+/// buckets indexed by the low-order bits (with the expected count for a random function),
+/// the longest chain, and the throughput over several passes through the words.
+template <typename H>
+void report(const string& name, const vector<string>& words, int m, H h) {
+    set<uint32_t> codes;
+    vector<int> load(m, 0);
+    int longest{0};
+    for (const string& w : words) {
+        uint64_t code = h(w);
+        codes.insert(static_cast<uint32_t>(code));
+        longest = max(longest, ++load[code & (m - 1)]);
+    }
+    int used{0};
+    for (int c : load)
+        if (c > 0) used++;
+    int n = words.size();
+    double expected{n - m * (1 - pow(1 - 1.0 / m, n))};   // for a uniformly random function
+
+    long bytes{0};
+    uint64_t sink{0};
+    int passes{0};
+    auto start = high_resolution_clock::now();
+    auto stop = start;
+    do {
+        for (const string& w : words) {
+            sink += h(w);
+            bytes += w.size();
+        }
+        passes++;
+        stop = high_resolution_clock::now();
+    } while (duration_cast<milliseconds>(stop-start).count() < 200);
+    double seconds{duration_cast<microseconds>(stop-start).count() / 1e6};
+
+    cout << left << setw(18) << name << right
+         << setw(10) << (n - codes.size())
+         << setw(10) << (n - used) << setw(10) << long(expected)
+         << setw(8) << longest
+         << setw(10) << fixed << setprecision(1) << (bytes / seconds / 1e6)
+         << setw(10) << (n * double(passes) / seconds / 1e6)
+         << (sink == 42 ? " " : "") << endl;                      // (prevents dead-code elimination)
+}
+
+/// Hash-quality and throughput report for the distinct words read from standard input
+void stats(int m) {
+    set<string> distinct;
+    string token;
+    while (cin >> token)
+        distinct.insert(token);
+    vector<string> words(distinct.begin(), distinct.end());
+    if (m == 0)
+        for (m = 1; m < words.size(); m *= 2) ;                   // table at least as large as word count
+
+    cout << words.size() << " distinct words, " << m << " buckets" << endl << endl;
+    cout << left << setw(18) << "hash" << right << setw(10) << "32-bit" << setw(10) << "bucket"
+         << setw(10) << "expected" << setw(8) << "longest" << setw(10) << "MB/s" << setw(10) << "Mkeys/s" << endl;
+    report("hash_code", words, m, [](string_view s) { return hash_code(s); });
+    report("std::hash", words, m, hash<string_view>());
+    report("fast_hash", words, m, [](string_view s) { return fast_hash(s); });
+    report("SeededStringHash", words, m, SeededStringHash());
+}
+
+/// With no arguments, prints the hash code of each token read from standard input.
+/// With argument --stats (optionally followed by a power-of-two number of buckets),
+/// reports collision rates and throughput of several string hashes on those tokens.
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && string(argv[1]) == "--stats") {
+        stats(argc >= 3 ? stoi(argv[2]) : 0);
+        return 0;
+    }
     string token;
     while (cin >> token) {
         cout << "hash_code(\"" << token << "\") is " << hash_code(token) << endl;
     }
 
 }
+
+
+/*
+Sample output of --stats, for the identifiers in this repository's source files
+(first), and for long strings made by joining 20 identifiers at a time (second):
+
+2819 distinct words, 4096 buckets
+
+hash                  32-bit    bucket  expected longest      MB/s   Mkeys/s
+hash_code                685      1906       780      33     432.2      61.2
+std::hash                  0       770       780       5     800.4     113.4
+fast_hash                  0       777       780       5    1436.4     203.5
+SeededStringHash           0       808       780       5    1276.9     180.9
+
+18886 distinct words, 32768 buckets
+
+hash                  32-bit    bucket  expected longest      MB/s   Mkeys/s
+hash_code              10337     15477      4531     179     761.6       6.7
+std::hash                  0      4453      4531       7    3241.0      28.4
+fast_hash                  0      4500      4531       5    5841.4      51.2
+SeededStringHash           0      4597      4531       5    5755.5      50.4
+
+*/
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>    // provides std::pow
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "heavy_hitters.h"
+#include "probe_hash_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// Returns a stream of n keys with a skewed (roughly Zipfian) distribution over [0, range)
+vector<int> skewed_stream(int n, int range) {
+    mt19937 rng(n);
+    uniform_real_distribution<double> unit(0, 1);
+    vector<int> stream;
+    for (int j = 0; j < n; j++)
+        stream.push_back(int(pow(range, unit(rng))) - 1);
+    return stream;
+}
+
+/// Returns a stream of n keys in which every fourth is one of five heavy keys 0 to 4 (with
+/// frequencies in proportion 5:4:3:2:1) and every other key occurs only once
+vector<int> distinct_stream(int n) {
+    const vector<int> heavy{0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 3, 3, 4};
+    vector<int> stream;
+    for (int j = 0; j < n; j++)
+        stream.push_back(j % 4 == 0 ? heavy[j / 4 % heavy.size()] : 1000 + j);
+    return stream;
+}
+
+/// Checks that top_k agrees with sorting every entry
+void test_exact(const vector<int>& stream, int k) {
+    ProbeHashMap<int,int> freq;
+    for (int key : stream)
+        freq.upsert(key, 1, [](int& count) { count++; });
+    vector<pair<int,int>> all;                                  // (-count, key), so most frequent first
+    for (auto entry : freq)
+        all.push_back({-entry.value(), entry.key()});
+    sort(all.begin(), all.end());
+
+    vector<HeavyHitter<int>> top{top_k(freq, k)};
+    bool ok{top.size() == min(k, freq.size())};
+    for (int j = 0; ok && j < top.size(); j++)
+        ok = (top[j].count == -all[j].first && top[j].error == 0);
+    ok = ok && top_k(freq, 0).empty();
+    cout << "top_k (k=" << k << ")" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks the guarantees of Space-Saving: every key occurring more than n/capacity times
+/// is reported, and each count is at least the truth and at most the truth plus its error
+void test_space_saving(const vector<int>& stream, int capacity) {
+    std::map<int,long> truth;
+    SpaceSaving<int> summary(capacity);
+    for (int key : stream) {
+        truth[key]++;
+        summary.add(key);
+    }
+    vector<HeavyHitter<int>> top{summary.top(capacity)};
+    bool ok{top.size() == min<int>(capacity, truth.size())};
+    for (const HeavyHitter<int>& h : top)
+        ok = ok && h.count >= truth[h.key] && h.count - h.error <= truth[h.key] &&
+             h.error <= long(stream.size()) / capacity;
+    for (auto [key, count] : truth)
+        if (count > long(stream.size()) / capacity)
+            ok = ok && any_of(top.begin(), top.end(), [key = key](const HeavyHitter<int>& h) { return h.key == key; });
+    cout << "SpaceSaving (" << capacity << " counters)" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that Count-Min never underestimates (and usually stays within its error bound),
+/// and that its top candidates are the truly most frequent keys of a skewed stream
+void test_count_min(const vector<int>& stream, int k, int width) {
+    std::map<int,long> truth;
+    CountMinSketch<int> sketch(width);
+    CountMinTopK<int> tracker(k, width);
+    for (int key : stream) {
+        truth[key]++;
+        sketch.add(key);
+        tracker.add(key);
+    }
+    bool ok{true};
+    long excess{0};
+    for (auto [key, count] : truth) {
+        ok = ok && sketch.estimate(key) >= count;
+        excess += sketch.estimate(key) - count;
+    }
+    ok = ok && excess <= truth.size() * sketch.error_bound();  // the bound holds on average
+    vector<HeavyHitter<int>> top{tracker.top()};
+    ok = ok && top.size() == k;
+    for (int j = 0; ok && j < top.size(); j++)
+        ok = (top[j].key == j);                                 // key j is the (j+1)st most likely
+    cout << "CountMinTopK (k=" << k << ")" << (ok ? " passed" : " FAILED") << endl;
+}
+
+int main() {
+    vector<int> stream{skewed_stream(200000, 50000)};
+    test_exact(stream, 1);
+    test_exact(stream, 20);
+    test_exact(skewed_stream(10, 5), 20);
+    test_space_saving(stream, 100);
+    test_space_saving(stream, 1000);
+    test_count_min(stream, 5, 4096);
+    vector<int> distinct{distinct_stream(1200000)};            // far more distinct keys than counters
+    test_space_saving(distinct, 100);
+    test_count_min(distinct, 5, 4096);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#include <cstddef>  // provides offsetof
+#include <cstdio>   // provides std::remove
+#include <cstdlib>
+#include <cstring>  // provides std::memcpy
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "mapped_hash_map.h"
+#include "probe_hash_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// Returns true if opening the given file as a MappedHashMap<int> throws runtime_error
+bool rejects(const string& path) {
+    try {
+        MappedHashMap<int> bad(path);
+    } catch (runtime_error& e) {
+        return true;
+    }
+    return false;
+}
+
+/// Writes a ProbeHashMap<string,int> to a file, maps it, and checks that every key is found
+/// with its value, that absent keys are not found, and that damaged files are rejected.
+void test_round_trip(int n) {
+    const string path{"test_mapped_hash_map.tmp"};
+    ProbeHashMap<string,int> original;
+    for (int j = 0; j < n; j++)
+        original.put("key" + to_string(j), j * j);
+    write_mapped_hash_map(original, path, 12345);
+
+    bool ok{true};
+    {
+        MappedHashMap<int> mapped(path);
+        ok = mapped.size() == n;
+        for (int j = 0; ok && j < n; j++)
+            ok = mapped.contains("key" + to_string(j)) && mapped.at("key" + to_string(j)) == j * j;
+        for (int j = n; ok && j < 2 * n; j++)
+            ok = mapped.find("key" + to_string(j)) == nullptr;
+        int visited{0};
+        mapped.for_each([&](string_view k, int v) {
+            visited++;
+            ok = ok && original.at(string(k)) == v;
+        });
+        ok = ok && visited == n;
+        try {
+            mapped.at("absent");
+            ok = false;
+        } catch (out_of_range& e) { }
+    }
+
+    ok = ok && rejects("no_such_file.tmp");
+    ifstream in(path, ios::binary);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    MappedHeader header;
+    memcpy(&header, contents.data(), sizeof(header));
+    string full{contents};                                                               // no empty slot
+    for (uint64_t j = 0; j < header.slots; j++) {
+        char* tag{&full[header.slots_offset + j * sizeof(MappedSlot<int>) + offsetof(MappedSlot<int>, tag)]};
+        if (*tag == 0) *tag = 1;                                                         // (tags are odd)
+    }
+    ofstream(path, ios::binary | ios::trunc).write(full.data(), full.size());
+    {
+        MappedHashMap<int> mapped(path);
+        ok = ok && mapped.find("absent") == nullptr && (n == 0 || mapped.at("key0") == 0);
+    }
+    ofstream(path, ios::binary | ios::trunc).write(contents.data(), contents.size() / 2);   // truncated
+    ok = ok && rejects(path);
+    contents[0] = 'X';                                                                   // wrong magic
+    ofstream(path, ios::binary | ios::trunc).write(contents.data(), contents.size());
+    ok = ok && rejects(path);
+    remove(path.c_str());
+
+    cout << "MappedHashMap (" << n << " entries)" << (ok ? " passed" : " FAILED") << endl;
+}
+
+int main() {
+    test_round_trip(0);
+    test_round_trip(1);
+    test_round_trip(10000);
+    return EXIT_SUCCESS;
+}
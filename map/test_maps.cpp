@@ -0,0 +1,636 @@
+#include <algorithm>  // defines std::max
+#include <cstdlib>
+#include <iterator>   // defines std::distance, std::next
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "chain_hash_map.h"
+#include "eytzinger_map.h"
+#include "inline_chain_hash_map.h"
+#include "ordered_table_map.h"
+#include "perfect_hash_map.h"
+#include "probe_hash_map.h"
+#include "robin_hood_hash_map.h"
+#include "swiss_hash_map.h"
+#include "unordered_list_map.h"
+#include "searchtree/avl_tree_map.h"
+#include "searchtree/b_tree_map.h"
+#include "searchtree/red_black_tree_map.h"
+#include "searchtree/splay_tree_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// A ChainHashMap that rehashes incrementally, migrating one old bucket per put
+class IncrementalChainHashMap : public ChainHashMap<int,int> {
+  public:
+    IncrementalChainHashMap() { incremental_rehash(1); }
+};
+
+/// An OrderedTableMap that buffers up to 50 new entries before merging them into its table
+class BufferedTableMap : public OrderedTableMap<int,int> {
+  public:
+    BufferedTableMap() { set_buffer_capacity(50); }
+};
+
+/// Returns true if the map has exactly the same entries as the (trusted) std::map
+template <typename Map>
+bool same_contents(const Map& map, const std::map<int,int>& model) {
+    if (map.size() != model.size()) return false;
+    int count{0};
+    for (auto entry : map) {
+        auto it = model.find(entry.key());
+        if (it == model.end() || it->second != entry.value()) return false;
+        count++;
+    }
+    return count == model.size();
+}
+
+/// Returns a std::map with the same entries as the given map
+template <typename Map>
+std::map<int,int> to_std_map(const Map& map) {
+    std::map<int,int> result;
+    for (auto entry : map)
+        result[entry.key()] = entry.value();
+    return result;
+}
+
+/// Performs a random sequence of put/upsert/erase/find operations on the map, comparing
+/// results with std::map, and finally erases every odd key during a traversal (which must
+/// visit each entry exactly once).
+template <typename Map>
+void test(const string& name, int operations, int range) {
+    Map map;
+    std::map<int,int> model;
+    mt19937 rng(operations);
+    bool ok{true};
+    for (int j = 0; ok && j < operations; j++) {
+        int k = rng() % range;
+        switch (rng() % 3) {
+          case 0:
+            if (j % 2 == 0) {
+                map.put(k, j);
+                model[k] = j;
+            } else {                                   // increment existing value, or insert j
+                map.upsert(k, j, [](int& v) { v++; });
+                if (model.count(k)) model[k]++; else model[k] = j;
+            }
+            break;
+          case 1:
+            ok = (map.erase(k) == (model.erase(k) == 1));
+            break;
+          default:
+            ok = (map.contains(k) == (model.count(k) == 1));
+            if (ok && model.count(k)) ok = (map.at(k) == model[k]);
+        }
+        if (j % 1000 == 0) ok = ok && same_contents(map, model);
+    }
+    ok = ok && same_contents(map, model);
+
+    std::map<int,int> visits;
+    auto walk = map.begin();                       // erase odd keys while iterating
+    while (ok && walk != map.end()) {
+        ok = (++visits[walk->key()] == 1);
+        if (walk->key() % 2 == 1) {
+            model.erase(walk->key());
+            walk = map.erase(walk);
+        } else
+            ++walk;
+    }
+    ok = ok && same_contents(map, model);
+
+    cout << name << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Fills many maps to the given load factor (where clusters often wrap around the end of
+/// a linear-probing table), then erases entries while traversing, checking that every entry
+/// is visited exactly once and that the erased ones are gone
+template <typename Map>
+void test_traversal_erase(const string& name, float load, int rounds) {
+    bool ok{true};
+    for (int r = 0; ok && r < rounds; r++) {
+        mt19937 rng(r);
+        Map map;
+        map.max_load_factor(load);
+        std::map<int,int> model;
+        int n = 20 + rng() % 200;
+        while (model.size() < n) {
+            int k = rng();
+            map.put(k, r);
+            model[k] = r;
+        }
+        std::map<int,int> visits;
+        for (auto walk = map.begin(); ok && walk != map.end(); ) {
+            int k{walk->key()};
+            ok = (++visits[k] == 1);
+            if (rng() % 2) {
+                model.erase(k);
+                walk = map.erase(walk);
+            } else
+                ++walk;
+        }
+        ok = ok && visits.size() == n && same_contents(map, model);
+    }
+    cout << name << " erasure during traversal (load " << load << ")" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that reserve(n) allows n insertions without any further change to the table size
+template <typename Map>
+void test_reserve(const string& name, float load, int n) {
+    Map map;
+    map.max_load_factor(load);
+    map.reserve(n);
+    int buckets{map.bucket_count()};
+    for (int j = 0; j < n; j++)
+        map.put(j, j);
+    bool ok{map.bucket_count() == buckets && map.load_factor() <= load && map.size() == n};
+    cout << name << " reserve" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Fills a map until one more entry would exceed its maximum load factor, and checks that
+/// overwriting values (by put or upsert) leaves the table alone, while one new key grows it
+template <typename Map>
+void test_overwrite(const string& name) {
+    Map map;
+    int n{0};
+    while (n < 1000 || n + 1 <= map.max_load_factor() * map.bucket_count())
+        map.put(n++, 0);
+    int buckets{map.bucket_count()};
+    for (int j = 0; j < n; j++) {
+        map.put(j, -j);
+        map.upsert(j, 0, [](int& v) { v--; });
+    }
+    bool ok{map.bucket_count() == buckets && map.size() == n && map.at(n - 1) == -n};
+    map.put(n, n);
+    ok = ok && map.bucket_count() > buckets && map.size() == n + 1;
+    cout << name << " overwrite at load limit" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that the maximum load factor is validated by the map itself, even when it is set
+/// through a reference to AbstractHashMap: open addressing must reject a limit of 1 or more
+/// (or its table could fill, and unsuccessful searches would never end)
+template <typename Map>
+void test_load_limit(const string& name, bool open_addressing) {
+    Map map;
+    AbstractHashMap<int,int,hash<int>>& base{map};
+    int rejected{0};
+    for (float f : {0.0f, 1.0f, 2.0f})
+        try {
+            base.max_load_factor(f);
+        } catch (invalid_argument& e) {
+            rejected++;
+        }
+    bool ok{rejected == (open_addressing ? 3 : 1)};
+    base.max_load_factor(0.9);
+    for (int j = 0; j < 1000; j++)
+        map.put(j, j);
+    ok = ok && map.load_factor() <= 0.9 && !map.contains(-1);
+    cout << name << " load limit" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that an incremental rehash with the given step (under the given maximum load
+/// factor) always completes before the table grows again, while entries are both added and
+/// erased, so that no put has to finish a rehash all at once
+void test_incremental_rehash(int step, float load, int n) {
+    ChainHashMap<int,int> map;
+    map.max_load_factor(load);
+    map.incremental_rehash(step);
+    mt19937 rng(n);
+    bool ok{true};
+    int growths{0};
+    for (int j = 0; ok && j < n; j++) {
+        bool busy{map.rehashing()};
+        int buckets{map.bucket_count()};
+        map.put(j, j);
+        if (rng() % 4 == 0) map.erase(rng() % (j + 1));
+        if (map.bucket_count() != buckets) {
+            growths++;
+            ok = !busy;                                      // previous rehash had completed
+        }
+    }
+    ok = ok && growths > 5;
+    cout << "ChainHashMap incremental rehash (step " << step << ", load " << load << ")"
+         << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that build_from sizes the table only once, and that find_batch agrees with find
+template <typename Map>
+void test_batch(const string& name, int n) {
+    vector<pair<int,int>> items;
+    for (int j = 0; j < n; j++)
+        items.push_back({3 * j, j});
+    Map map;
+    map.reserve(n);
+    int buckets{map.bucket_count()};
+    Map built;
+    built.build_from(items.begin(), items.end());
+    bool ok{built.size() == n && built.bucket_count() == buckets};
+
+    vector<int> keys;
+    for (int j = 0; j < 2 * n; j++)
+        keys.push_back(j);                                   // a third of these are present
+    vector<typename Map::const_iterator> found;
+    built.find_batch(keys.begin(), keys.end(), back_inserter(found));
+    ok = ok && found.size() == keys.size();
+    for (int j = 0; ok && j < keys.size(); j++)
+        ok = (found[j] == built.find(keys[j]));
+    cout << name << " batch" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that a PerfectHashMap built from a map finds exactly that map's entries, and
+/// (for a large map) that its metadata stays within a few bits per key
+template <typename Map>
+void test_perfect(const string& name, int n) {
+    Map source;
+    mt19937 rng(n);
+    for (int j = 0; j < n; j++)
+        source.put(rng() % (4 * n), j);
+    PerfectHashMap<int,int> perfect(source);
+    bool ok{perfect.size() == source.size() && same_contents(perfect, to_std_map(source))};
+    for (int k = 0; ok && k < 4 * n; k++)
+        ok = (perfect.contains(k) == source.contains(k));
+    if (n >= 10000) ok = ok && perfect.bits_per_key() < 5;
+    try {
+        perfect.put(0, 0);
+        ok = false;
+    } catch (logic_error& e) { }
+    cout << "PerfectHashMap from " << name << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks PerfectHashMaps built from many small maps, with keys from a wide range (so
+/// that their hash codes cover both groups of buckets), against random queries
+void test_perfect_small(int n, int rounds) {
+    bool ok{true};
+    for (int r = 0; ok && r < rounds; r++) {
+        mt19937 rng(1000 * n + r);
+        ChainHashMap<int,int> source;
+        while (source.size() < n)
+            source.put(rng() % 1000000000, r);
+        PerfectHashMap<int,int> perfect(source);
+        ok = perfect.size() == n && same_contents(perfect, to_std_map(source));
+        for (int j = 0; ok && j < 100; j++) {
+            int k = rng() % 1000000000;
+            ok = (perfect.contains(k) == source.contains(k));
+        }
+    }
+    cout << "PerfectHashMap (" << n << " entries, " << rounds << " key sets)" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that an EytzingerMap built from a map agrees with an OrderedTableMap of the
+/// same entries on find, lower_bound, and upper_bound for every key in range (and beyond)
+template <typename Map>
+void test_eytzinger(const string& name, int n) {
+    Map source;
+    OrderedTableMap<int,int> sorted;
+    mt19937 rng(n);
+    for (int j = 0; j < n; j++) {
+        int k = rng() % (4 * n);
+        source.put(k, j);
+        sorted.put(k, j);
+    }
+    EytzingerMap<int,int> eytzinger(source);
+    bool ok{eytzinger.size() == sorted.size() && same_contents(eytzinger, to_std_map(sorted))};
+    auto position = [](const auto& map, auto it) {           // index of it within iteration order
+        int j{0};
+        for (auto walk = map.begin(); walk != it; ++walk) j++;
+        return j;
+    };
+    for (int k = -1; ok && k <= 4 * n; k += (n > 1000 ? 7 : 1)) {
+        ok = (eytzinger.contains(k) == sorted.contains(k)) &&
+             position(eytzinger, eytzinger.lower_bound(k)) == position(sorted, sorted.lower_bound(k)) &&
+             position(eytzinger, eytzinger.upper_bound(k)) == position(sorted, sorted.upper_bound(k));
+        if (ok && sorted.contains(k)) ok = (eytzinger.at(k) == sorted.at(k));
+    }
+    if (ok && n > 0) ok = ((--eytzinger.end())->key() == (--sorted.end())->key());
+    try {
+        eytzinger.put(0, 0);
+        ok = false;
+    } catch (logic_error& e) { }
+    cout << "EytzingerMap from " << name << " (" << n << " entries)" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Checks that bulk_load adds a sorted range to a map (empty or not, buffered or not),
+/// overwriting existing keys, and rejects a range that is out of order
+void test_bulk_load(int buffer_capacity) {
+    OrderedTableMap<int,int> map;
+    map.set_buffer_capacity(buffer_capacity);
+    std::map<int,int> model;
+    vector<pair<int,int>> evens, thirds;
+    for (int j = 0; j < 1000; j++) {
+        evens.push_back({2 * j, j});
+        thirds.push_back({3 * j, -j});
+    }
+    map.bulk_load(evens.begin(), evens.end());
+    model.insert(evens.begin(), evens.end());
+    for (int j = 1; j < 300; j += 2) {                       // a few buffered entries
+        map.put(j, j);
+        model[j] = j;
+    }
+    map.bulk_load(thirds.begin(), thirds.end());
+    for (auto [k, v] : thirds)
+        model[k] = v;
+    bool ok{same_contents(map, model)};
+    auto walk = map.end();                                   // traverse backward
+    for (auto it = model.rbegin(); ok && it != model.rend(); ++it)
+        ok = ((--walk)->key() == it->first);
+    for (int k = -1; ok && k <= 3000; k++) {
+        auto lower = map.lower_bound(k), upper = map.upper_bound(k);
+        ok = (lower == map.end() ? model.lower_bound(k) == model.end() : lower->key() == model.lower_bound(k)->first) &&
+             (upper == map.end() ? model.upper_bound(k) == model.end() : upper->key() == model.upper_bound(k)->first);
+    }
+    try {
+        map.bulk_load(evens.rbegin(), evens.rend());
+        ok = false;
+    } catch (invalid_argument& e) { }
+    cout << "OrderedTableMap bulk_load (buffer capacity " << buffer_capacity << ")"
+         << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// An AVLTreeMap that can check its heights, balance, subtree sizes and parent links
+class CheckedAVLTreeMap : public dsac::search_tree::AVLTreeMap<int,int> {
+  public:
+    using AVLTreeMap::AVLTreeMap;
+    bool valid() const { return check(tree.sentinel()->left) >= 0; }
+  private:
+    // Returns the height of the subtree at p, or -1 if it is invalid
+    int check(Node* p) const {
+        if (p == nullptr) return 0;
+        int a{check(p->left)}, b{check(p->right)};
+        if (a < 0 || b < 0 || abs(a - b) > 1 || aux(p) != 1 + max(a, b) ||
+            p->element.size != 1 + subtree_size(p->left) + subtree_size(p->right) ||
+            (p->left != nullptr && p->left->parent != p) || (p->right != nullptr && p->right->parent != p))
+            return -1;
+        return aux(p);
+    }
+};
+
+/// A RedBlackTreeMap that can check its colors, subtree sizes and parent links
+class CheckedRedBlackTreeMap : public dsac::search_tree::RedBlackTreeMap<int,int> {
+  public:
+    using RedBlackTreeMap::RedBlackTreeMap;
+    bool valid() const { return !stale && !is_red(tree.sentinel()->left) && check(tree.sentinel()->left) >= 0; }
+  private:
+    bool stale{false};                        // was a recorded black height ever wrong?
+
+    // also checks the black heights recorded for detached subtrees
+    Node* join_subtrees(Node* left, Node* mid, Node* right) override {
+        if (recorded_height(left) != black_height(left) || recorded_height(right) != black_height(right))
+            stale = true;
+        Node* result{RedBlackTreeMap::join_subtrees(left, mid, right)};
+        if (recorded_height(result) != black_height(result))
+            stale = true;
+        return result;
+    }
+
+    // Returns the black height of the subtree at p, or -1 if it is invalid
+    int check(Node* p) const {
+        if (p == nullptr) return 0;
+        int a{check(p->left)}, b{check(p->right)};
+        if (a < 0 || a != b || (is_red(p) && (is_red(p->left) || is_red(p->right))) ||
+            p->element.size != 1 + subtree_size(p->left) + subtree_size(p->right) ||
+            (p->left != nullptr && p->left->parent != p) || (p->right != nullptr && p->right->parent != p))
+            return -1;
+        return a + (is_red(p) ? 0 : 1);
+    }
+};
+
+/// Builds a map from sorted entries, then repeatedly splits it at a random key, changes
+/// both parts (so that they differ in height), and joins them again, checking the contents
+/// and balance of every map along the way
+template <typename Map>
+void test_split_join(const string& name, int n) {
+    vector<pair<int,int>> items;
+    for (int j = 0; j < n; j++)
+        items.push_back({3 * j, j});
+    Map map(items.begin(), items.end());
+    std::map<int,int> model(items.begin(), items.end());
+    bool ok{map.valid() && same_contents(map, model)};
+    mt19937 rng(n);
+    for (int round = 0; ok && round < 100; round++) {
+        int k = int(rng() % (3 * n + 2)) - 1;
+        Map greater;
+        map.split(k, greater);
+        std::map<int,int> upper(model.lower_bound(k), model.end());
+        model.erase(model.lower_bound(k), model.end());
+        ok = map.valid() && greater.valid() && same_contents(map, model) && same_contents(greater, upper);
+        int changes = rng() % 200;
+        for (int j = 0; ok && j < changes; j++) {
+            int key = rng() % (3 * n + 3);
+            Map& part{key < k ? map : greater};
+            std::map<int,int>& part_model{key < k ? model : upper};
+            if (rng() % 2) {
+                part.put(key, j);
+                part_model[key] = j;
+            } else {
+                part.erase(key);
+                part_model.erase(key);
+            }
+        }
+        map.join(greater);
+        model.insert(upper.begin(), upper.end());
+        ok = ok && greater.empty() && map.valid() && same_contents(map, model);
+    }
+    try {
+        Map low(items.begin(), items.begin() + n / 2);
+        low.join(map);                                           // overlapping keys
+        ok = ok && n < 2;
+    } catch (invalid_argument& e) { }
+    try {
+        Map reversed(items.rbegin(), items.rend());
+        ok = ok && n < 2;
+    } catch (invalid_argument& e) { }
+    cout << name << " build/split/join (" << n << " entries)" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Joins maps with pooled nodes, destroying the joined map before reusing the emptied one
+/// (whose nodes, and former end sentinel, were taken over by the joined map)
+template <typename Map>
+void test_pooled_join(const string& name, int n) {
+    vector<pair<int,int>> items;
+    for (int j = 0; j < 2 * n; j++)
+        items.push_back({j, j});
+    Map greater(items.begin() + n, items.end());
+    bool ok{true};
+    {
+        Map lesser(items.begin(), items.begin() + n);
+        lesser.join(greater);
+        ok = lesser.size() == 2 * n && greater.empty() && same_contents(lesser, std::map<int,int>(items.begin(), items.end()));
+    }
+    std::map<int,int> model;
+    for (int j = 0; j < n; j++) {
+        greater.put(j, -j);
+        model[j] = -j;
+    }
+    ok = ok && same_contents(greater, model);
+    cout << name << " join (" << n << " entries each)" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Compares unite, intersect and subtract (with the given number of threads) against std::map,
+/// for random maps with m and n entries, whose keys overlap in part, checking the balance of the
+/// results
+template <typename Map>
+void test_set_operations(const string& name, int m, int n, int threads) {
+    mt19937 rng(m + n);
+    std::map<int,int> a, b;
+    while (a.size() < m) a[rng() % (2 * (m + n) + 1)] = rng() % 1000;
+    while (b.size() < n) b[rng() % (2 * (m + n) + 1)] = rng() % 1000;
+    auto sum{[](int x, int y) { return x + y; }};
+
+    std::map<int,int> both{a}, common, only;
+    for (auto [k, v] : b)
+        both[k] += v;
+    for (auto [k, v] : a)
+        if (b.count(k)) common[k] = v + b[k]; else only[k] = v;
+
+    Map x(a.begin(), a.end()), y(b.begin(), b.end());
+    x.unite(y, sum, threads);
+    bool ok{x.valid() && y.valid() && y.empty() && same_contents(x, both)};
+    Map p(a.begin(), a.end()), q(b.begin(), b.end());
+    p.intersect(q, sum, threads);
+    ok = ok && p.valid() && q.empty() && same_contents(p, common);
+    Map r(a.begin(), a.end()), s(b.begin(), b.end());
+    r.subtract(s, threads);
+    ok = ok && r.valid() && s.empty() && same_contents(r, only);
+    try {
+        x.unite(x, sum);
+        ok = false;
+    } catch (invalid_argument& e) { }
+    cout << name << " set operations (" << m << " and " << n << " entries, " << threads << " threads)"
+         << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Performs random put, upsert and erase operations on a tree map maintaining the given
+/// aggregate, periodically comparing select, rank, count_range and aggregate with std::map
+template <template <typename...> class TreeMap, template <typename,typename> class Augment>
+void test_order_statistics(const string& name, int operations, int range) {
+    typedef Augment<int,int> A;
+    TreeMap<int,int,less<int>,dsac::tree::HeapNodes,A> map;
+    std::map<int,int> model;
+    mt19937 rng(operations);
+    bool ok{true};
+    for (int j = 0; ok && j < operations; j++) {
+        int k = rng() % range;
+        switch (rng() % 3) {
+          case 0:
+            map.put(k, j);
+            model[k] = j;
+            break;
+          case 1: {                                    // decrease existing value, or insert j
+            dsac::map::AbstractMap<int,int>& base{map};
+            if (j % 2)
+                map.upsert(k, j, [](int& v) { v -= 5; });
+            else                                       // aggregates must also follow the base class
+                base.upsert(k, j, [](int& v) { v -= 5; });
+            if (model.count(k)) model[k] -= 5; else model[k] = j;
+            break;
+          }
+          default:
+            map.erase(k);
+            model.erase(k);
+        }
+        if (j % 100 == 0 && !model.empty()) {
+            int a = rng() % range, b = a + rng() % (range / 4);
+            int r = rng() % model.size();
+            typename A::type total{A::identity()};
+            for (auto it = model.lower_bound(a); it != model.upper_bound(b); ++it)
+                total = A::combine(total, A::of(it->first, it->second));
+            ok = map.select(r)->key() == next(model.begin(), r)->first &&
+                 map.rank(a) == distance(model.begin(), model.lower_bound(a)) &&
+                 map.count_range(a, b) == distance(model.lower_bound(a), model.upper_bound(b)) &&
+                 map.count_range(b, a - 1) == 0 && map.aggregate(a, b) == total;
+        }
+    }
+    ok = ok && same_contents(map, model);
+    typename A::type total{A::identity()};
+    for (auto [k, v] : model)
+        total = A::combine(total, A::of(k, v));
+    ok = ok && map.aggregate() == total;
+    try {
+        map.select(map.size());
+        ok = false;
+    } catch (out_of_range& e) { }
+    cout << name << " order statistics" << (ok ? " passed" : " FAILED") << endl;
+}
+
+int main() {
+    test<UnorderedListMap<int,int>>("UnorderedListMap", 5000, 300);
+    test<OrderedTableMap<int,int>>("OrderedTableMap", 20000, 2000);
+    test<BufferedTableMap>("OrderedTableMap (buffered)", 20000, 2000);
+    test<dsac::search_tree::AVLTreeMap<int,int>>("AVLTreeMap", 20000, 2000);
+    test<dsac::search_tree::RedBlackTreeMap<int,int>>("RedBlackTreeMap", 20000, 2000);
+    test<dsac::search_tree::AVLTreeMap<int,int,less<int>,dsac::tree::PooledNodes>>("AVLTreeMap (pooled nodes)", 20000, 2000);
+    test<dsac::search_tree::RedBlackTreeMap<int,int,less<int>,dsac::tree::PooledNodes>>("RedBlackTreeMap (pooled nodes)", 20000, 2000);
+    test<dsac::search_tree::BTreeMap<int,int>>("BTreeMap", 20000, 2000);
+    test<dsac::search_tree::BTreeMap<int,int,less<int>,3>>("BTreeMap (order 3)", 20000, 2000);
+    test<dsac::search_tree::BTreeMap<int,int,less<int>,4>>("BTreeMap (order 4)", 20000, 2000);
+    test_order_statistics<dsac::search_tree::AVLTreeMap, dsac::search_tree::SumOfValues>("AVLTreeMap (sum)", 20000, 2000);
+    test_order_statistics<dsac::search_tree::RedBlackTreeMap, dsac::search_tree::MaxOfValues>("RedBlackTreeMap (max)", 20000, 2000);
+    test_order_statistics<dsac::search_tree::SplayTreeMap, dsac::search_tree::SumOfValues>("SplayTreeMap (sum)", 20000, 2000);
+    for (int n : {0, 1, 2, 7, 8, 1000})
+        test_split_join<CheckedAVLTreeMap>("AVLTreeMap", n);
+    for (int n : {0, 1, 2, 7, 8, 1000})
+        test_split_join<CheckedRedBlackTreeMap>("RedBlackTreeMap", n);
+    test_pooled_join<dsac::search_tree::AVLTreeMap<int,int,less<int>,dsac::tree::PooledNodes>>("AVLTreeMap (pooled nodes)", 1000);
+    test_pooled_join<dsac::search_tree::RedBlackTreeMap<int,int,less<int>,dsac::tree::PooledNodes>>("RedBlackTreeMap (pooled nodes)", 1000);
+    for (auto [m, n] : {pair{0, 0}, {0, 5}, {5, 0}, {10, 10000}, {10000, 10}, {20000, 20000}}) {
+        test_set_operations<CheckedAVLTreeMap>("AVLTreeMap", m, n, 1);
+        test_set_operations<CheckedRedBlackTreeMap>("RedBlackTreeMap", m, n, 1);
+    }
+    test_set_operations<CheckedAVLTreeMap>("AVLTreeMap", 50000, 50000, 4);
+    test_set_operations<CheckedRedBlackTreeMap>("RedBlackTreeMap", 50000, 50000, 4);
+    test<ProbeHashMap<int,int>>("ProbeHashMap", 100000, 5000);
+    test<ProbeHashMap<int,int,hash<int>,PowerOfTwoSizing>>("ProbeHashMap (power of two)", 100000, 5000);
+    test<ProbeHashMap<int,int,hash<int>,FastRangeSizing>>("ProbeHashMap (fastrange)", 100000, 5000);
+    test<ChainHashMap<int,int>>("ChainHashMap", 100000, 5000);
+    test<ChainHashMap<int,int,hash<int>,PowerOfTwoSizing>>("ChainHashMap (power of two)", 100000, 5000);
+    test<ChainHashMap<int,int,hash<int>,FastRangeSizing>>("ChainHashMap (fastrange)", 100000, 5000);
+    test<IncrementalChainHashMap>("ChainHashMap (incremental)", 100000, 5000);
+    test<IncrementalChainHashMap>("ChainHashMap (incremental, large)", 1000000, 200000);
+    for (float load : {0.5f, 1.0f, 3.0f})
+        test_incremental_rehash(1, load, 200000);
+    test<InlineChainHashMap<int,int>>("InlineChainHashMap", 100000, 5000);
+    test<InlineChainHashMap<int,int,hash<int>,PrimeSizing,1>>("InlineChainHashMap (1 inline)", 100000, 5000);
+    test<RobinHoodHashMap<int,int>>("RobinHoodHashMap", 100000, 5000);
+    test<RobinHoodHashMap<int,int,hash<int>,PowerOfTwoSizing>>("RobinHoodHashMap (power of two)", 100000, 5000);
+    test_traversal_erase<RobinHoodHashMap<int,int>>("RobinHoodHashMap", 0.95, 2000);
+    test_traversal_erase<ProbeHashMap<int,int>>("ProbeHashMap", 0.95, 2000);
+    test<SwissHashMap<int,int>>("SwissHashMap", 100000, 5000);
+    test<SwissHashMap<int,int>>("SwissHashMap (large)", 1000000, 200000);
+    test_overwrite<ProbeHashMap<int,int>>("ProbeHashMap");
+    test_overwrite<RobinHoodHashMap<int,int>>("RobinHoodHashMap");
+    test_overwrite<ChainHashMap<int,int>>("ChainHashMap");
+    test_overwrite<IncrementalChainHashMap>("ChainHashMap (incremental)");
+    test_overwrite<InlineChainHashMap<int,int>>("InlineChainHashMap");
+    test_load_limit<ProbeHashMap<int,int>>("ProbeHashMap", true);
+    test_load_limit<RobinHoodHashMap<int,int>>("RobinHoodHashMap", true);
+    test_load_limit<ChainHashMap<int,int>>("ChainHashMap", false);
+    test_load_limit<InlineChainHashMap<int,int>>("InlineChainHashMap", false);
+    test_reserve<ProbeHashMap<int,int>>("ProbeHashMap", 0.75, 10000);
+    test_reserve<RobinHoodHashMap<int,int>>("RobinHoodHashMap", 0.9, 10000);
+    test_reserve<ChainHashMap<int,int,hash<int>,PowerOfTwoSizing>>("ChainHashMap (power of two)", 2.0, 10000);
+    test_reserve<ChainHashMap<int,int,hash<int>,FastRangeSizing>>("ChainHashMap (fastrange)", 1.0, 10000);
+    test_reserve<InlineChainHashMap<int,int>>("InlineChainHashMap", 2.0, 10000);
+    test_batch<ProbeHashMap<int,int>>("ProbeHashMap", 10000);
+    test_batch<ChainHashMap<int,int>>("ChainHashMap", 10000);
+    test_batch<IncrementalChainHashMap>("ChainHashMap (incremental)", 10000);
+    test_batch<InlineChainHashMap<int,int>>("InlineChainHashMap", 10000);
+    test_perfect<ChainHashMap<int,int>>("ChainHashMap", 0);
+    test_perfect<ChainHashMap<int,int>>("ChainHashMap", 1);
+    test_perfect<ChainHashMap<int,int>>("ChainHashMap", 50000);
+    for (int n : {1, 2, 3})
+        test_perfect_small(n, 1000);
+    test_perfect<OrderedTableMap<int,int>>("OrderedTableMap", 5000);
+    test_batch<RobinHoodHashMap<int,int>>("RobinHoodHashMap", 10000);
+    test_eytzinger<ChainHashMap<int,int>>("ChainHashMap", 0);
+    test_eytzinger<ChainHashMap<int,int>>("ChainHashMap", 1);
+    test_eytzinger<ChainHashMap<int,int>>("ChainHashMap", 100);
+    test_eytzinger<OrderedTableMap<int,int>>("OrderedTableMap", 1000);
+    test_eytzinger<ChainHashMap<int,int>>("ChainHashMap", 5000);
+    test_bulk_load(0);
+    test_bulk_load(50);
+    return EXIT_SUCCESS;
+}
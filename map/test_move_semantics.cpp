@@ -0,0 +1,104 @@
+#include <cstdlib>  // provides EXIT_SUCCESS, std::malloc, std::free
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "chain_hash_map.h"
+#include "ordered_table_map.h"
+#include "probe_hash_map.h"
+#include "robin_hood_hash_map.h"
+#include "swiss_hash_map.h"
+#include "unordered_list_map.h"
+#include "searchtree/avl_tree_map.h"
+#include "searchtree/b_tree_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// Counts every call to the global allocator made by this program
+static long allocations{0};
+
+void* operator new(size_t n) {
+    allocations++;
+    if (void* p = malloc(n)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/// A string wrapper that counts how many times any instance is copied
+class Tracked {
+  private:
+    string s;
+  public:
+    static long copies;
+
+    Tracked(string str = "") : s{std::move(str)} {}
+    Tracked(const Tracked& other) : s{other.s} { copies++; }
+    Tracked(Tracked&& other) noexcept : s{std::move(other.s)} {}
+    Tracked& operator=(const Tracked& other) { s = other.s; copies++; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { s = std::move(other.s); return *this; }
+
+    const string& str() const { return s; }
+    bool operator==(const Tracked& other) const { return s == other.s; }
+    bool operator!=(const Tracked& other) const { return s != other.s; }
+    bool operator<(const Tracked& other) const { return s < other.s; }
+};
+long Tracked::copies{0};
+
+struct TrackedHash {
+    size_t operator()(const Tracked& t) const { return hash<string>()(t.str()); }
+};
+
+/// Returns a key long enough that copying it must allocate
+string long_key(int j) { return "a reasonably long key that defeats the small string optimization #" + to_string(j); }
+
+/// Inserts n entries with rvalue keys and values (growing the map several times), then
+/// overwrites each value, and finally uses try_emplace and insert_or_assign. None of this
+/// should copy a key or value, nor allocate for a key or value beyond building them.
+template <typename Map>
+void test(const string& name, int n) {
+    Map map;
+    vector<Tracked> keys, values;
+    for (int j = 0; j < n; j++) {
+        keys.emplace_back(long_key(j));
+        values.emplace_back(long_key(-j));
+    }
+
+    Tracked::copies = 0;
+    long before{allocations};
+    for (int j = 0; j < n; j++)
+        map.put(std::move(keys[j]), std::move(values[j]));
+    long put_allocations{allocations - before};
+
+    for (int j = 0; j < n; j++)
+        map.put(Tracked(long_key(j)), Tracked("updated"));            // overwrite existing values
+    for (int j = 0; j < n; j++)
+        map.try_emplace(Tracked(long_key(j)), "ignored");             // key exists, so no effect
+    auto result = map.try_emplace(Tracked(long_key(n)), "new");       // inserted
+    auto assigned = map.insert_or_assign(Tracked(long_key(0)), Tracked("assigned"));
+
+    bool ok{Tracked::copies == 0 && map.size() == n + 1 && result.second && !assigned.second};
+    for (int j = 0; ok && j < n; j++)
+        ok = (map.at(Tracked(long_key(j))).str() == (j == 0 ? "assigned" : "updated"));
+    ok = ok && map.at(Tracked(long_key(n))).str() == "new";
+
+    cout << name << (ok ? " passed" : " FAILED") << " (" << Tracked::copies << " copies, "
+         << double(put_allocations) / n << " allocations per put)" << endl;
+}
+
+int main() {
+    int n{5000};
+    test<UnorderedListMap<Tracked,Tracked>>("UnorderedListMap", 500);
+    test<OrderedTableMap<Tracked,Tracked>>("OrderedTableMap", n);
+    test<ProbeHashMap<Tracked,Tracked,TrackedHash>>("ProbeHashMap", n);
+    test<ChainHashMap<Tracked,Tracked,TrackedHash>>("ChainHashMap", n);
+    test<RobinHoodHashMap<Tracked,Tracked,TrackedHash>>("RobinHoodHashMap", n);
+    test<SwissHashMap<Tracked,Tracked,TrackedHash>>("SwissHashMap", n);
+    test<dsac::search_tree::AVLTreeMap<Tracked,Tracked>>("AVLTreeMap", n);
+    test<dsac::search_tree::AVLTreeMap<Tracked,Tracked,less<Tracked>,dsac::tree::PooledNodes>>("AVLTreeMap (pooled nodes)", n);
+    test<dsac::search_tree::BTreeMap<Tracked,Tracked>>("BTreeMap", n);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "read_mostly_hash_map.h"
+
+using namespace std;
+using namespace dsac::map;
+
+/// A value that counts how many instances currently exist, to detect leaks
+struct Counted {
+    static atomic<int> live;
+    int v;
+    Counted(int v = 0) : v{v} { live++; }
+    Counted(const Counted& other) : v{other.v} { live++; }
+    Counted& operator=(const Counted& other) = default;
+    ~Counted() { live--; }
+};
+atomic<int> Counted::live{0};
+
+/// Performs a random sequence of single-threaded operations, comparing results with std::map
+void test_sequential(int operations, int range) {
+    bool ok{true};
+    {
+        ReadMostlyHashMap<int,Counted> map;
+        std::map<int,int> model;
+        mt19937 rng(operations);
+        for (int j = 0; ok && j < operations; j++) {
+            int k = rng() % range;
+            switch (rng() % 3) {
+              case 0:
+                ok = (map.put(k, j) == (model.count(k) == 0));
+                model[k] = j;
+                break;
+              case 1:
+                ok = (map.erase(k) == (model.erase(k) == 1));
+                break;
+              default:
+                ok = (map.contains(k) == (model.count(k) == 1));
+                if (ok && model.count(k)) ok = (map.at(k).v == model[k]);
+            }
+        }
+        int visited{0};
+        map.for_each([&](const auto& entry) {
+            visited++;
+            ok = ok && model.count(entry.key()) && model[entry.key()] == entry.value().v;
+        });
+        ok = ok && visited == model.size() && map.size() == model.size();
+    }
+    ok = ok && Counted::live == 0;
+    cout << "ReadMostlyHashMap sequential" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Writer threads repeatedly insert, update and erase keys, always with a value of 2k or 2k+1
+/// for key k, while reader threads look up keys and traverse the map, checking that every
+/// value seen belongs to its key. Finally, no value may be leaked once the map is destroyed.
+void test_stress(int num_writers, int num_readers, int rounds, int range) {
+    atomic<bool> ok{true};
+    {
+        ReadMostlyHashMap<int,Counted> map;
+        atomic<int> writers_left{num_writers};
+        vector<thread> workers;
+        for (int t = 0; t < num_writers; t++)
+            workers.emplace_back([&, t]() {
+                mt19937 rng(t);
+                for (int j = 0; j < rounds; j++) {
+                    int k = rng() % range;
+                    if (rng() % 3 == 0)
+                        map.erase(k);
+                    else
+                        map.put(k, 2 * k + j % 2);
+                }
+                writers_left--;
+            });
+        for (int t = 0; t < num_readers; t++)
+            workers.emplace_back([&, t]() {
+                mt19937 rng(100 + t);
+                for (int j = 0; writers_left > 0; j++) {
+                    int k = rng() % range;
+                    auto v = map.find(k);
+                    if (v && v->v / 2 != k) ok = false;
+                    if (j % 1000 == 0)
+                        map.for_each([&](const auto& entry) {
+                            if (entry.value().v / 2 != entry.key()) ok = false;
+                        });
+                }
+            });
+        for (thread& w : workers) w.join();
+
+        int visited{0};
+        map.for_each([&](const auto&) { visited++; });
+        ok = ok && visited == map.size();
+    }
+    ok = ok && Counted::live == 0;
+    cout << "ReadMostlyHashMap stress" << (ok ? " passed" : " FAILED") << endl;
+}
+
+/// Holds depth guards at once (as deeply nested traversals might), retires an object while
+/// all are held, and returns true if the object survives each reclaim until the outermost
+/// guard is released
+bool nested_guards(EpochManager& epochs, int depth) {
+    auto guard{epochs.guard()};
+    if (depth == 1)
+        epochs.retire(new Counted(1));
+    else if (!nested_guards(epochs, depth - 1))
+        return false;
+    epochs.reclaim();
+    return epochs.pending() == 1;
+}
+
+/// Checks that more readers than the manager has slots (the rest sharing its overflow slot)
+/// can be pinned at once, both by one thread and by many threads, and that an object
+/// retired meanwhile is neither reclaimed early nor leaked
+void test_epoch_overflow(int guards, int threads) {
+    bool ok;
+    {
+        EpochManager epochs;
+        ok = nested_guards(epochs, guards);
+        epochs.reclaim();
+        ok = ok && epochs.pending() == 0;
+
+        atomic<int> pinned{0};
+        atomic<bool> release{false};
+        vector<thread> readers;
+        for (int t = 0; t < threads; t++)
+            readers.emplace_back([&]() {
+                auto guard{epochs.guard()};
+                pinned++;
+                while (!release) this_thread::yield();
+            });
+        while (pinned < threads) this_thread::yield();
+        epochs.retire(new Counted(2));
+        epochs.reclaim();
+        ok = ok && epochs.pending() == 1;
+        release = true;
+        for (thread& r : readers) r.join();
+        epochs.reclaim();
+        ok = ok && epochs.pending() == 0;
+    }
+    ok = ok && Counted::live == 0;
+    cout << "EpochManager with " << guards << " nested guards and " << threads << " pinned readers"
+         << (ok ? " passed" : " FAILED") << endl;
+}
+
+int main() {
+    test_sequential(100000, 5000);
+    test_stress(2, 6, 200000, 10000);
+    test_epoch_overflow(300, 200);
+    return EXIT_SUCCESS;
+}
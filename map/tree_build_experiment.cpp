@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>   // provides std::stoi
+#include <utility>
+#include <vector>
+
+#include "searchtree/avl_tree_map.h"
+#include "searchtree/red_black_tree_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::search_tree;
+
+/// Reports the time since start, for the given number of operations
+void report(const string& name, high_resolution_clock::time_point start, int operations) {
+    auto stop = high_resolution_clock::now();
+    double elapsed = duration_cast<nanoseconds>(stop-start).count();
+    cout << setw(32) << left << name << right << setw(9) << fixed << setprecision(1)
+         << elapsed / 1000000 << " milliseconds (" << operations << " operations)" << endl;
+}
+
+/// Loads the sorted items into a map with one put per entry and with the constructor that
+/// builds from a sorted range, and then splits the map at random keys, joining the two
+/// parts back together after each split
+template <typename Map>
+void experiment(const string& name, const vector<pair<int,int>>& items, int rounds) {
+    int n = items.size();
+    cout << name << ":" << endl;
+    {
+        auto start = high_resolution_clock::now();
+        Map map;
+        for (auto [k, v] : items)
+            map.put(k, v);
+        report("  put in increasing order", start, n);
+    }
+    auto start = high_resolution_clock::now();
+    Map map(items.begin(), items.end());
+    report("  build from sorted", start, n);
+
+    mt19937 rng(n);
+    start = high_resolution_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        Map greater;
+        map.split(items[rng() % n].first, greater);
+        map.join(greater);
+    }
+    report("  split and join", start, rounds);
+    if (map.size() != n) cout << "  (map has the wrong size)" << endl;
+}
+
+/// The command line arguments set the number of entries and the number of split/join rounds
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 1000000};            // number of entries (default 1000000)
+    int rounds{argc >= 3 ? stoi(argv[2]) : 100000};        // split/join rounds (default 100000)
+
+    vector<pair<int,int>> items;
+    for (int j = 0; j < n; j++)
+        items.push_back({2 * j, j});
+    experiment<AVLTreeMap<int,int>>("AVLTreeMap", items, rounds);
+    experiment<RedBlackTreeMap<int,int>>("RedBlackTreeMap", items, rounds);
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (default arguments):
+
+AVLTreeMap:
+  put in increasing order           203.5 milliseconds (1000000 operations)
+  build from sorted                  70.0 milliseconds (1000000 operations)
+  split and join                    352.1 milliseconds (100000 operations)
+RedBlackTreeMap:
+  put in increasing order           255.6 milliseconds (1000000 operations)
+  build from sorted                  64.5 milliseconds (1000000 operations)
+  split and join                    429.4 milliseconds (100000 operations)
+
+*/
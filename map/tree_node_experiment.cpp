@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>  // provides EXIT_SUCCESS, std::malloc, std::free
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>   // provides std::stoi
+#include <vector>
+
+#include "searchtree/avl_tree_map.h"
+#include "searchtree/red_black_tree_map.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace dsac::search_tree;
+using dsac::tree::HeapNodes, dsac::tree::PooledNodes;
+
+/// Counts every call to the global allocator made by this program
+static long allocations{0};
+
+void* operator new(size_t n) {
+    allocations++;
+    if (void* p = malloc(n)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/// Reports the time and allocations since the given starting point, for the given number of operations
+void report(const char* phase, high_resolution_clock::time_point start, long before, int operations) {
+    auto stop = high_resolution_clock::now();
+    cout << "    " << setw(8) << left << phase << right << setw(7) << duration_cast<milliseconds>(stop-start).count()
+         << " milliseconds, " << setw(8) << allocations - before << " allocations ("
+         << operations << " operations)" << endl;
+}
+
+/// Inserts n distinct keys in random order, erases half of them, reinserts those (so that
+/// erased nodes may be reused), and finally destroys the map
+template <typename Map>
+void experiment(const char* name, const vector<int>& keys) {
+    int n = keys.size();
+    cout << name << ":" << endl;
+    Map* map = new Map();
+
+    auto start = high_resolution_clock::now();
+    long before{allocations};
+    for (int k : keys)
+        map->put(k, k);
+    report("insert", start, before, n);
+
+    start = high_resolution_clock::now();
+    before = allocations;
+    for (int j = 0; j < n; j += 2)
+        map->erase(keys[j]);
+    report("erase", start, before, n / 2);
+
+    start = high_resolution_clock::now();
+    before = allocations;
+    for (int j = 0; j < n; j += 2)
+        map->put(keys[j], j);
+    report("reinsert", start, before, n / 2);
+
+    start = high_resolution_clock::now();
+    before = allocations;
+    delete map;
+    report("destroy", start, before, n);
+}
+
+/// The command line argument sets the number of entries
+int main(int argc, char* argv[]) {
+    int n{argc >= 2 ? stoi(argv[1]) : 1000000};           // number of entries (default 1000000)
+
+    vector<int> keys(n);
+    for (int j = 0; j < n; j++)
+        keys[j] = j;
+    shuffle(keys.begin(), keys.end(), mt19937(n));
+
+    experiment<AVLTreeMap<int,int,less<int>,HeapNodes>>("AVLTreeMap (heap nodes)", keys);
+    experiment<AVLTreeMap<int,int,less<int>,PooledNodes>>("AVLTreeMap (pooled nodes)", keys);
+    experiment<RedBlackTreeMap<int,int,less<int>,HeapNodes>>("RedBlackTreeMap (heap nodes)", keys);
+    experiment<RedBlackTreeMap<int,int,less<int>,PooledNodes>>("RedBlackTreeMap (pooled nodes)", keys);
+    return EXIT_SUCCESS;
+}
+
+
+/*
+Sample output (default arguments):
+
+AVLTreeMap (heap nodes):
+    insert     1297 milliseconds,  1000000 allocations (1000000 operations)
+    erase       763 milliseconds,        0 allocations (500000 operations)
+    reinsert    880 milliseconds,   500000 allocations (500000 operations)
+    destroy     158 milliseconds,        0 allocations (1000000 operations)
+AVLTreeMap (pooled nodes):
+    insert     1092 milliseconds,       29 allocations (1000000 operations)
+    erase       708 milliseconds,        0 allocations (500000 operations)
+    reinsert    713 milliseconds,        0 allocations (500000 operations)
+    destroy       0 milliseconds,        0 allocations (1000000 operations)
+RedBlackTreeMap (heap nodes):
+    insert     1190 milliseconds,  1000000 allocations (1000000 operations)
+    erase       656 milliseconds,        0 allocations (500000 operations)
+    reinsert    726 milliseconds,   500000 allocations (500000 operations)
+    destroy     163 milliseconds,        0 allocations (1000000 operations)
+RedBlackTreeMap (pooled nodes):
+    insert     1152 milliseconds,       29 allocations (1000000 operations)
+    erase       805 milliseconds,        0 allocations (500000 operations)
+    reinsert    720 milliseconds,        0 allocations (500000 operations)
+    destroy       0 milliseconds,        0 allocations (1000000 operations)
+
+*/
@@ -1,22 +1,61 @@
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <string>                     // provides std::stoi
+#include <vector>
 
+#include "heavy_hitters.h"
 #include "probe_hash_map.h"
 
 using namespace std;
 using namespace dsac::map;
 #define Map ProbeHashMap
 
-int main() {
-    Map<string,int> freq;             // maps strings to count of occurrences
+/// Prints a numbered list of heavy hitters
+void report(const vector<HeavyHitter<string>>& top) {
+    for (int j = 0; j < top.size(); j++) {
+        cout << setw(4) << j + 1 << ". " << top[j].key << " (" << top[j].count;
+        if (top[j].error > 0)
+            cout << ", overestimated by at most " << top[j].error;
+        cout << ")" << endl;
+    }
+}
+
+/// With no arguments, reports the most frequent word of standard input. With argument k,
+/// lists the k most frequent words instead; a second argument of "space-saving" or
+/// "count-min" chooses an approximate method whose memory does not grow with the
+/// number of distinct words (by default, words are counted exactly).
+int main(int argc, char* argv[]) {
     string word;
-    while (cin >> word) {             // continue reading until ctrl-D
-        int count{1};                 // count for this occurrence
-        if (freq.contains(word))
-            count += freq.at(word);   // and previous occurrences
-        freq.put(word, count);
+    if (argc >= 2) {
+        int k{stoi(argv[1])};
+        string method{argc >= 3 ? argv[2] : "exact"};
+        if (method == "space-saving") {
+            SpaceSaving<string> summary(10 * k);      // extra counters improve accuracy
+            while (cin >> word)
+                summary.add(word);
+            report(summary.top(k));
+        } else if (method == "count-min") {
+            CountMinTopK<string> tracker(k, 1 << 16);
+            while (cin >> word)
+                tracker.add(word);
+            report(tracker.top());
+        } else if (method == "exact") {
+            Map<string,int> freq;
+            while (cin >> word)
+                freq.upsert(word, 1, [](int& count) { count++; });
+            report(top_k(freq, k));
+        } else {
+            cerr << "Usage: " << argv[0] << " [k [exact|space-saving|count-min]]" << endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
     }
 
+    Map<string,int> freq;             // maps strings to count of occurrences
+    while (cin >> word)               // continue reading until ctrl-D
+        freq.upsert(word, 1, [](int& count) { count++; });   // first occurrence, or one more
+
     int max_count{0};
     string max_word{""};
     for (Map<string,int>::Entry entry : freq) {
@@ -25,7 +64,7 @@ int main() {
             max_word = entry.key();
         }
     }
-    
+
     cout << "The most frequent word is '" << max_word
          << "' with " << max_count << " occurrences." << endl;
 }
@@ -0,0 +1,37 @@
+#pragma once
+#include <algorithm>     // defines std::max
+#include <limits>        // defines std::numeric_limits
+
+namespace dsac::search_tree {
+
+// An augmentation lets a TreeMap maintain, for each subtree, an aggregate of its entries
+// under an associative operation (a monoid), so that the aggregate over any range of keys
+// can be computed in time proportional to the height of the tree. An augmentation provides
+//
+//     type                        the type of an aggregate
+//     identity()                  the aggregate of no entries
+//     of(key, value)              the aggregate of a single entry
+//     combine(a, b)               the aggregate of entries a followed by entries b
+
+/// No aggregate is maintained (the default)
+struct NoAugment { };
+
+/// Maintains the sum of the values in each subtree
+template <typename Key, typename Value>
+struct SumOfValues {
+    typedef Value type;
+    static Value identity() { return Value(); }
+    static Value of(const Key&, const Value& v) { return v; }
+    static Value combine(const Value& a, const Value& b) { return a + b; }
+};
+
+/// Maintains the largest value in each subtree (the lowest possible value, if empty)
+template <typename Key, typename Value>
+struct MaxOfValues {
+    typedef Value type;
+    static Value identity() { return std::numeric_limits<Value>::lowest(); }
+    static Value of(const Key&, const Value& v) { return v; }
+    static Value combine(const Value& a, const Value& b) { return std::max(a, b); }
+};
+
+} // namespace dsac::search_tree
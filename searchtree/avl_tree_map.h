@@ -9,10 +9,11 @@
 
 namespace dsac::search_tree {
 
-template <typename Key, typename Value, typename Compare=std::less<Key>>
-class AVLTreeMap : public TreeMap<Key,Value,Compare> {
+template <typename Key, typename Value, typename Compare=std::less<Key>, typename Nodes=dsac::tree::HeapNodes,
+          typename Augment=NoAugment>
+class AVLTreeMap : public TreeMap<Key,Value,Compare,Nodes,Augment> {
   protected:
-    typedef TreeMap<Key,Value,Compare> Base;
+    typedef TreeMap<Key,Value,Compare,Nodes,Augment> Base;
     using Base::tree, Base::aux, Base::set_aux, typename Base::Node;
     
     /// Returns the height of the given node (nullptr is considered 0)
@@ -69,6 +70,85 @@ class AVLTreeMap : public TreeMap<Key,Value,Compare> {
         if (p != tree.sentinel())
             rebalance(p);
     }
+
+    // Sets the height of a node built by build_from_sorted, after its children
+    void rebalance_build(Node* p, int, int) { recompute_height(p); }
+
+    /// Joins detached subtrees (as described in TreeMap). If one subtree is taller by more
+    /// than one, this descends along the inner side of the taller subtree to a subtree of
+    /// nearly equal height, links the other subtree there, and rebalances on the way back up.
+    Node* join_subtrees(Node* left, Node* mid, Node* right) {
+        if (height(left) > height(right) + 1) return join_right(left, mid, right);
+        if (height(right) > height(left) + 1) return join_left(left, mid, right);
+        Base::make_subtree(left, mid, right);
+        recompute_height(mid);
+        return mid;
+    }
+
+    // Joins subtree t (which is more than one taller than right) with mid and right,
+    // descending along the right side of t; returns the root of the joined subtree
+    Node* join_right(Node* t, Node* mid, Node* right) {
+        Node* s;
+        if (height(t->right) <= height(right) + 1) {
+            s = Base::make_subtree(t->right, mid, right);
+            recompute_height(s);
+        } else {
+            s = join_right(t->right, mid, right);
+        }
+        tree.relink(t, s, false);
+        Base::refresh(t);
+        recompute_height(t);
+        if (height(s) <= height(t->left) + 1)
+            return t;
+        if (height(s->left) > height(s->right)) {                   // double rotation
+            Node* g{s->left};
+            tree.rotate(g);
+            recompute_height(s);
+            recompute_height(g);
+            s = g;
+        }
+        tree.rotate(s);
+        recompute_height(t);
+        recompute_height(s);
+        return s;
+    }
+
+    // Joins subtree t (which is more than one taller than left) with left and mid,
+    // descending along the left side of t; returns the root of the joined subtree
+    Node* join_left(Node* left, Node* mid, Node* t) {
+        Node* s;
+        if (height(t->left) <= height(left) + 1) {
+            s = Base::make_subtree(left, mid, t->left);
+            recompute_height(s);
+        } else {
+            s = join_left(left, mid, t->left);
+        }
+        tree.relink(t, s, true);
+        Base::refresh(t);
+        recompute_height(t);
+        if (height(s) <= height(t->right) + 1)
+            return t;
+        if (height(s->right) > height(s->left)) {                   // double rotation
+            Node* g{s->right};
+            tree.rotate(g);
+            recompute_height(s);
+            recompute_height(g);
+            s = g;
+        }
+        tree.rotate(s);
+        recompute_height(t);
+        recompute_height(s);
+        return s;
+    }
+
+  public:
+    /// Creates an empty map
+    AVLTreeMap() {}
+
+    /// Creates a map with the (key, value) pairs in the range [first, last), which must have
+    /// strictly increasing keys, as a perfectly balanced tree in O(n) time
+    template <typename ForwardIt>
+    AVLTreeMap(ForwardIt first, ForwardIt last) { Base::build_from_sorted(first, last); }
 };
 
 } // namespace dsac::map
@@ -0,0 +1,432 @@
+#pragma once
+#include <functional>    // defines std::less
+#include <stdexcept>
+#include <utility>
+
+#include "map/abstract_map.h"
+
+namespace dsac::search_tree {
+
+/// A sorted map implemented as a B-tree, in which each node stores up to Order-1 entries
+/// (and an internal node up to Order children) in contiguous arrays. Every node other than
+/// the root has at least (Order-1)/2 entries, and all leaves have the same depth, so a search
+/// visits about log(n)/log(Order/2) nodes, rather than the log2(n) nodes (each a separate
+/// cache miss on a large map) visited by a binary search tree. The map supports the same
+/// operations as TreeMap, including lower_bound, upper_bound, and bidirectional iteration.
+template <typename Key, typename Value, typename Compare=std::less<Key>, int Order=32>
+class BTreeMap : public dsac::map::AbstractMap<Key,Value> {
+    static_assert(Order >= 3, "a B-tree node must allow at least three children");
+  protected:
+    typedef dsac::map::AbstractMap<Key,Value> Base;           // shorthand for the base class
+
+  public:
+    using Base::empty, Base::erase, typename Base::Entry, typename Base::const_iterator;
+
+  protected:
+    static constexpr int MAX{Order - 1};                      // most entries in a node
+    static constexpr int MIN{(Order - 1) / 2};                // fewest entries in a non-root node
+
+    struct Internal;
+
+    //------ nested Node classes ------
+    struct Node {
+        Entry entries[Order];      // entries[0..n-1] in order, with room for one more during a split
+        int n{0};                  // number of entries
+        bool leaf;
+        Internal* parent{nullptr};
+        int pos{0};                // index of this node among its parent's children
+
+        Node(bool is_leaf) : leaf{is_leaf} {}
+    };
+
+    struct Internal : Node {
+        Node* children[Order + 1]; // children[0..n], where children[j] has keys between entries j-1 and j
+
+        Internal() : Node(false) {}
+    };
+
+    // instance variables for a BTreeMap
+    Node* root{nullptr};           // nullptr when the map is empty
+    int sz{0};
+    Compare less_than;             // determines "a < b" relationship among keys
+
+    static Internal* internal(Node* x) { return static_cast<Internal*>(x); }
+    static Node* child(const Node* x, int j) { return static_cast<const Internal*>(x)->children[j]; }
+
+    // Makes c the j-th child of x
+    static void link(Internal* x, int j, Node* c) {
+        x->children[j] = c;
+        c->parent = x;
+        c->pos = j;
+    }
+
+    // Frees node x (but not its children)
+    static void release(Node* x) {
+        if (x->leaf)
+            delete x;
+        else
+            delete internal(x);
+    }
+
+    // Frees the subtree rooted at x
+    static void tear_down(Node* x) {
+        if (!x->leaf)
+            for (int j = 0; j <= x->n; j++)
+                tear_down(child(x, j));
+        release(x);
+    }
+
+    // Returns a copy of the subtree rooted at model
+    static Node* clone(const Node* model) {
+        Node* x{model->leaf ? new Node(true) : new Internal()};
+        x->n = model->n;
+        for (int j = 0; j < model->n; j++)
+            x->entries[j] = model->entries[j];
+        if (!model->leaf)
+            for (int j = 0; j <= model->n; j++)
+                link(internal(x), j, clone(child(model, j)));
+        return x;
+    }
+
+    static Node* leftmost(Node* x) {
+        while (!x->leaf) x = child(x, 0);
+        return x;
+    }
+
+    static Node* rightmost(Node* x) {
+        while (!x->leaf) x = child(x, x->n);
+        return x;
+    }
+
+    // Returns the number of entries of x whose keys satisfy go_right (which must hold for
+    // a prefix of the keys in order), using a binary search
+    template <typename GoRight>
+    static int count(const Node* x, GoRight go_right) {
+        int lo{0}, hi{x->n};
+        while (lo < hi) {
+            int mid{(lo + hi) / 2};
+            if (go_right(x->entries[mid].key()))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // A position is a node and the index of an entry within it; the end is a null node.
+
+    // Moves position (x,i), where i may equal x->n, upward until it refers to an entry
+    static void climb(Node*& x, int& i) {
+        while (x != nullptr && i == x->n) {
+            i = x->pos;
+            x = x->parent;
+        }
+    }
+
+    // Advances position (x,i) to the next entry in order
+    static void next(Node*& x, int& i) {
+        if (!x->leaf) {
+            x = leftmost(child(x, i + 1));           // first entry of the subtree to the right
+            i = 0;
+        } else {
+            i++;
+            climb(x, i);
+        }
+    }
+
+    // Moves position (x,i) to the previous entry in order (from the end, to the last entry)
+    static void previous(Node*& x, int& i, Node* root) {
+        if (x == nullptr) {
+            x = rightmost(root);
+            i = x->n - 1;
+        } else if (!x->leaf) {
+            x = rightmost(child(x, i));              // last entry of the subtree to the left
+            i = x->n - 1;
+        } else if (i > 0) {
+            i--;
+        } else {
+            while (x->parent != nullptr && x->pos == 0)
+                x = x->parent;
+            i = x->pos - 1;
+            x = x->parent;
+        }
+    }
+
+    // a position within our map is described by a node pointer and index
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator;
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {    // specialize abstract version
+      public:
+        const BTreeMap* map;
+        Node* node;
+        int i;
+        iter_rep(const BTreeMap* m, Node* nd, int i) : map{m}, node{nd}, i{i} {}
+
+        const Entry& entry() const { return node->entries[i]; }
+        void advance() { next(node, i); }
+        void retreat() { previous(node, i, map->root); }
+        bool equals(const abstract_iter_rep* other) const {
+            const iter_rep* p = dynamic_cast<const iter_rep*>(other);   // cast abstract argument to our iter_rep
+            return p != nullptr && map == p->map && node == p->node && (node == nullptr || i == p->i);
+        }
+    };  //------- end of class iter_rep --------
+
+    // Returns the first position whose key does not satisfy go_right (or the end)
+    template <typename GoRight>
+    iter_rep search(GoRight go_right) const {
+        iter_rep result(this, nullptr, 0);
+        for (Node* x = root; x != nullptr; ) {
+            int i{count(x, go_right)};
+            if (i < x->n) {                          // a candidate, smaller than any found above
+                result.node = x;
+                result.i = i;
+            }
+            x = (x->leaf ? nullptr : child(x, i));
+        }
+        return result;
+    }
+
+    // Splits overflowing node x, moving its median entry up to the parent, and then splits
+    // any ancestor that overflows as a result. Position (t,ti) is updated to follow its entry.
+    void split(Node* x, Node*& t, int& ti) {
+        while (x->n > MAX) {
+            int m{x->n / 2};
+            Node* y{x->leaf ? new Node(true) : new Internal()};   // receives entries after the median
+            y->n = x->n - m - 1;
+            for (int j = 0; j < y->n; j++)
+                y->entries[j] = std::move(x->entries[m + 1 + j]);
+            if (!x->leaf)
+                for (int j = 0; j <= y->n; j++)
+                    link(internal(y), j, child(x, m + 1 + j));
+            x->n = m;
+
+            Internal* p{x->parent};
+            if (p == nullptr) {                      // x was the root, so the tree grows taller
+                p = new Internal();
+                link(p, 0, x);
+                root = p;
+            }
+            int j{x->pos};
+            for (int r = p->n; r > j; r--) {         // make room for the median and y
+                p->entries[r] = std::move(p->entries[r - 1]);
+                link(p, r + 1, p->children[r]);
+            }
+            p->entries[j] = std::move(x->entries[m]);
+            link(p, j + 1, y);
+            p->n++;
+
+            if (t == x && ti > m) {
+                t = y;
+                ti -= m + 1;
+            } else if (t == x && ti == m) {
+                t = p;
+                ti = j;
+            } else if (t == p && ti >= j) {
+                ti++;
+            }
+            x = p;
+        }
+    }
+
+    // Merges the j-th and (j+1)-st children of p, together with the entry between them
+    void merge(Internal* p, int j) {
+        Node* a{p->children[j]};
+        Node* b{p->children[j + 1]};
+        a->entries[a->n] = std::move(p->entries[j]);
+        for (int r = 0; r < b->n; r++)
+            a->entries[a->n + 1 + r] = std::move(b->entries[r]);
+        if (!a->leaf)
+            for (int r = 0; r <= b->n; r++)
+                link(internal(a), a->n + 1 + r, child(b, r));
+        a->n += 1 + b->n;
+        for (int r = j + 1; r < p->n; r++) {         // close the gap in the parent
+            p->entries[r - 1] = std::move(p->entries[r]);
+            link(p, r, p->children[r + 1]);
+        }
+        p->n--;
+        release(b);
+    }
+
+    // Restores the minimum occupancy of non-root node x, which has one entry too few, by
+    // moving an entry through the parent from a sibling that can spare one, or else by
+    // merging x with a sibling (which may leave the parent with too few entries)
+    void fix_underflow(Node* x) {
+        while (x != root && x->n < MIN) {
+            Internal* p{x->parent};
+            int j{x->pos};
+            Node* left{j > 0 ? p->children[j - 1] : nullptr};
+            Node* right{j < p->n ? p->children[j + 1] : nullptr};
+            if (left != nullptr && left->n > MIN) {              // rotate from left sibling
+                for (int r = x->n; r > 0; r--)
+                    x->entries[r] = std::move(x->entries[r - 1]);
+                x->entries[0] = std::move(p->entries[j - 1]);
+                p->entries[j - 1] = std::move(left->entries[left->n - 1]);
+                if (!x->leaf) {
+                    for (int r = x->n + 1; r > 0; r--)
+                        link(internal(x), r, child(x, r - 1));
+                    link(internal(x), 0, child(left, left->n));
+                }
+                left->n--;
+                x->n++;
+                return;
+            }
+            if (right != nullptr && right->n > MIN) {            // rotate from right sibling
+                x->entries[x->n] = std::move(p->entries[j]);
+                p->entries[j] = std::move(right->entries[0]);
+                for (int r = 1; r < right->n; r++)
+                    right->entries[r - 1] = std::move(right->entries[r]);
+                if (!x->leaf) {
+                    link(internal(x), x->n + 1, child(right, 0));
+                    for (int r = 0; r < right->n; r++)
+                        link(internal(right), r, child(right, r + 1));
+                }
+                right->n--;
+                x->n++;
+                return;
+            }
+            merge(p, left != nullptr ? j - 1 : j);
+            x = p;
+        }
+    }
+
+    // add/update Entry(k,v), copying or moving k and v as given
+    template <typename K, typename V>
+    const_iterator insert(K&& k, V&& v) {
+        if (root == nullptr)
+            root = new Node(true);
+        Node* x{root};
+        while (true) {
+            int i{count(x, [&](const Key& key) { return less_than(key, k); })};
+            if (i < x->n && !less_than(k, x->entries[i].key())) {         // exact match
+                x->entries[i].value() = std::forward<V>(v);                // update entry's value
+                return make_iterator(iter_rep(this, x, i));
+            }
+            if (x->leaf) {                                                // new entry goes here
+                for (int r = x->n; r > i; r--)
+                    x->entries[r] = std::move(x->entries[r - 1]);
+                x->entries[i] = Entry(std::forward<K>(k), std::forward<V>(v));
+                x->n++;
+                sz++;
+                split(x, x, i);                                           // (x,i) follows the new entry
+                return make_iterator(iter_rep(this, x, i));
+            }
+            x = child(x, i);
+        }
+    }
+
+  public:
+    /// Creates an empty map
+    BTreeMap() {}
+
+    /// Returns the number of entries in the map
+    int size() const { return sz; }
+
+    /// Returns a const_iterator to first entry
+    const_iterator begin() const { return make_iterator(iter_rep(this, root ? leftmost(root) : nullptr, 0)); }
+
+    /// Returns a const_iterator representing the end
+    const_iterator end() const { return make_iterator(iter_rep(this, nullptr, 0)); }
+
+    /// Returns a const_iterator to the entry with a given key, or end() if no such entry exists
+    const_iterator find(const Key& k) const {
+        iter_rep result{search([&](const Key& key) { return less_than(key, k); })};
+        if (result.node != nullptr && !less_than(k, result.entry().key()))   // exact match
+            return make_iterator(result);
+        else
+            return end();
+    }
+
+    /// Returns a const_iterator to the first entry with key greater than or equal to k, or end() if no such entry exists
+    const_iterator lower_bound(const Key& k) const {
+        return make_iterator(search([&](const Key& key) { return less_than(key, k); }));
+    }
+
+    /// Returns a const_iterator to the first entry with key strictly greater than k, or end() if no such entry exists
+    const_iterator upper_bound(const Key& k) const {
+        return make_iterator(search([&](const Key& key) { return !less_than(k, key); }));
+    }
+
+    /// Associates given key with given value. If key already exists previous value is overwritten.
+    /// Returns a const_iterator to the entry associated with the key
+    const_iterator put(const Key& k, const Value& v) { return insert(k, v); }
+
+    /// Same as above, but moving the key and value into the map
+    const_iterator put(Key&& k, Value&& v) { return insert(std::move(k), std::move(v)); }
+
+    /// Removes the entry indicated by the given iterator, and returns const_iterator to next entry in iteration order
+    const_iterator erase(const_iterator loc) {
+        iter_rep* rep = dynamic_cast<iter_rep*>(get_rep(loc));
+        Node* x{rep->node};
+        int i{rep->i};
+        Entry removed{std::move(x->entries[i])};
+        Node* leaf{x};
+        if (x->leaf) {
+            for (int r = i + 1; r < x->n; r++)
+                x->entries[r - 1] = std::move(x->entries[r]);
+        } else {                                                  // replace with predecessor
+            leaf = rightmost(child(x, i));
+            x->entries[i] = std::move(leaf->entries[leaf->n - 1]);
+        }
+        leaf->n--;
+        sz--;
+
+        bool underflow{leaf != root && leaf->n < MIN};
+        if (underflow)
+            fix_underflow(leaf);
+        if (root->n == 0) {                                       // the tree becomes shorter
+            Node* old{root};
+            root = (old->leaf ? nullptr : child(old, 0));
+            if (root != nullptr)
+                root->parent = nullptr;
+            release(old);
+        }
+
+        if (root == nullptr)
+            return end();
+        if (underflow)                                            // entries may have moved
+            return upper_bound(removed.key());
+        if (x->leaf)
+            climb(x, i);                                          // entry after the removed one
+        else
+            next(x, i);                                           // entry after the predecessor
+        return make_iterator(iter_rep(this, x, i));
+    }
+
+    // ------------- Rule of five support ----------------
+
+    /// Destructor
+    ~BTreeMap() { if (root != nullptr) tear_down(root); }
+
+    /// Copy constructor
+    BTreeMap(const BTreeMap& other)
+        : root{other.root != nullptr ? clone(other.root) : nullptr}, sz{other.sz}, less_than{other.less_than} {}
+
+    /// Copy assignment
+    BTreeMap& operator=(const BTreeMap& other) {
+        if (this != &other) {                                     // bypass self-assignment
+            BTreeMap temp{other};
+            std::swap(root, temp.root);                           // old structure destroyed with temp
+            std::swap(sz, temp.sz);
+            less_than = other.less_than;
+        }
+        return *this;
+    }
+
+    /// Move constructor
+    BTreeMap(BTreeMap&& other) : root{other.root}, sz{other.sz}, less_than{other.less_than} {
+        other.root = nullptr;
+        other.sz = 0;
+    }
+
+    /// Move assignment
+    BTreeMap& operator=(BTreeMap&& other) {
+        if (this != &other) {
+            std::swap(root, other.root);                          // old structure destroyed by other
+            std::swap(sz, other.sz);
+            std::swap(less_than, other.less_than);
+        }
+        return *this;
+    }
+};
+
+} // namespace dsac::search_tree
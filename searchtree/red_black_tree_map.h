@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>     // defines std::max
 #include <functional>    // defines std::less
 #include <cstdlib>       // provides abs
 #include <stdexcept>
@@ -9,21 +10,23 @@
 
 namespace dsac::search_tree {
 
-template <typename Key, typename Value, typename Compare=std::less<Key>>
-class RedBlackTreeMap : public TreeMap<Key,Value,Compare> {
+template <typename Key, typename Value, typename Compare=std::less<Key>, typename Nodes=dsac::tree::HeapNodes,
+          typename Augment=NoAugment>
+class RedBlackTreeMap : public TreeMap<Key,Value,Compare,Nodes,Augment> {
   protected:
-    typedef TreeMap<Key,Value,Compare> Base;
+    typedef TreeMap<Key,Value,Compare,Nodes,Augment> Base;
   public:
     using Base::size;
   protected:
     using Base::tree, Base::aux, Base::set_aux, typename Base::Node;
 
-    // we use the inherited aux field with convention that 0=red and 1=black
-    void make_black(Node* p) { set_aux(p, 1); }
-    void make_red(Node* p) { set_aux(p, 0); }
-    void set_color(Node* p, bool to_red) { set_aux(p, to_red ? 0 : 1); }
-    bool is_black(Node* p) const { return aux(p) == 1; }
-    bool is_red(Node* p) const { return p != nullptr && aux(p) == 0; }
+    // we use the low bit of the inherited aux field with convention that 0=red and 1=black;
+    // the other bits hold the black height of a detached subtree root (see join_subtrees)
+    void make_black(Node* p) { set_aux(p, aux(p) | 1); }
+    void make_red(Node* p) { set_aux(p, aux(p) & ~1); }
+    void set_color(Node* p, bool to_red) { if (to_red) make_red(p); else make_black(p); }
+    bool is_black(Node* p) const { return (aux(p) & 1) == 1; }
+    bool is_red(Node* p) const { return p != nullptr && (aux(p) & 1) == 0; }
     bool is_red_leaf(Node* p) const {
         return is_red(p) && p->left == nullptr && p->right == nullptr;
     }
@@ -116,6 +119,100 @@ class RedBlackTreeMap : public TreeMap<Key,Value,Compare> {
         }
     }
 
+    // Colors a node built by build_from_sorted: the deepest level of an incomplete tree is
+    // red, so that every path from the root to a null child has the same number of black nodes
+    void rebalance_build(Node* p, int depth, int max_depth) { set_color(p, depth == max_depth && depth > 0); }
+
+    // The root of the tree must be black
+    void rebalance_root(Node* p) { if (p != nullptr) make_black(p); }
+
+    // Returns the number of black nodes on each path from p down to a null child
+    int black_height(Node* p) const {
+        int h{0};
+        for (; p != nullptr; p = p->left)
+            if (!is_red(p)) h++;
+        return h;
+    }
+
+    // The black height of each detached subtree root is recorded within its aux field, so
+    // that join_subtrees need not walk down to compute it (which would make a split take
+    // O(log^2 n) time). It is computed once for a tree as a whole, and is derived for each
+    // other detached subtree from that of its former parent or by join_subtrees itself.
+    int recorded_height(Node* p) const { return (p == nullptr ? 0 : aux(p) >> 1); }
+    void record_height(Node* p, int h) { if (p != nullptr) set_aux(p, (h << 1) | (aux(p) & 1)); }
+
+    void rebalance_detach(Node* p) { record_height(p, black_height(p)); }
+
+    void rebalance_expose(Node* t, Node* left, Node* right) {
+        int h{recorded_height(t) - (is_black(t) ? 1 : 0)};
+        record_height(left, h);
+        record_height(right, h);
+    }
+
+    /// Joins detached subtrees (as described in TreeMap). If one subtree has greater black
+    /// height, this descends along the inner side of that subtree to a black node with the
+    /// black height of the other subtree, links the other subtree there below red mid, and
+    /// resolves any double red on the way back up. The joined subtree has a black root.
+    Node* join_subtrees(Node* left, Node* mid, Node* right) {
+        int lh{recorded_height(left)}, rh{recorded_height(right)};
+        Node* result;
+        if (lh > rh)
+            result = join_right(left, lh, mid, right, rh);
+        else if (rh > lh)
+            result = join_left(left, lh, mid, right, rh);
+        else
+            result = Base::make_subtree(left, mid, right);
+        int h{lh == rh ? lh + 1 : std::max(lh, rh) + (is_red(result) ? 1 : 0)};
+        make_black(result);
+        record_height(result, h);
+        return result;
+    }
+
+    // Joins subtree t (with black height th) with mid and right (with smaller black height
+    // rh), descending along the right side of t; returns the root of the joined subtree
+    Node* join_right(Node* t, int th, Node* mid, Node* right, int rh) {
+        if (!is_red(t) && th == rh) {                       // t may be nullptr
+            make_red(mid);
+            return Base::make_subtree(t, mid, right);
+        }
+        Node* s{join_right(t->right, th - (is_red(t) ? 0 : 1), mid, right, rh)};
+        tree.relink(t, s, false);
+        Base::refresh(t);
+        if (!is_red(t) && is_red(s) && is_red(s->right)) {  // double red below black t
+            make_black(s->right);
+            tree.rotate(s);
+            return s;
+        }
+        return t;
+    }
+
+    // Joins subtree t (with black height th) with left (with smaller black height lh) and
+    // mid, descending along the left side of t; returns the root of the joined subtree
+    Node* join_left(Node* left, int lh, Node* mid, Node* t, int th) {
+        if (!is_red(t) && th == lh) {                       // t may be nullptr
+            make_red(mid);
+            return Base::make_subtree(left, mid, t);
+        }
+        Node* s{join_left(left, lh, mid, t->left, th - (is_red(t) ? 0 : 1))};
+        tree.relink(t, s, true);
+        Base::refresh(t);
+        if (!is_red(t) && is_red(s) && is_red(s->left)) {   // double red below black t
+            make_black(s->left);
+            tree.rotate(s);
+            return s;
+        }
+        return t;
+    }
+
+  public:
+    /// Creates an empty map
+    RedBlackTreeMap() {}
+
+    /// Creates a map with the (key, value) pairs in the range [first, last), which must have
+    /// strictly increasing keys, as a perfectly balanced tree in O(n) time
+    template <typename ForwardIt>
+    RedBlackTreeMap(ForwardIt first, ForwardIt last) { Base::build_from_sorted(first, last); }
+
   /*
   // ------------ debugging follows ------------
   public:
@@ -9,10 +9,11 @@
 
 namespace dsac::search_tree {
 
-template <typename Key, typename Value, typename Compare=std::less<Key>>
-class SplayTreeMap : public TreeMap<Key,Value,Compare> {
+template <typename Key, typename Value, typename Compare=std::less<Key>, typename Nodes=dsac::tree::HeapNodes,
+          typename Augment=NoAugment>
+class SplayTreeMap : public TreeMap<Key,Value,Compare,Nodes,Augment> {
   protected:
-    typedef TreeMap<Key,Value,Compare> Base;
+    typedef TreeMap<Key,Value,Compare,Nodes,Augment> Base;
     using Base::tree, typename Base::Node;
 
     void splay(Node* p) {
@@ -41,6 +42,15 @@ class SplayTreeMap : public TreeMap<Key,Value,Compare> {
     void rebalance_delete(Node* p) {
         if (p != tree.sentinel()) splay(p);
     }
+
+  public:
+    /// Creates an empty map
+    SplayTreeMap() {}
+
+    /// Creates a map with the (key, value) pairs in the range [first, last), which must have
+    /// strictly increasing keys, as a perfectly balanced tree in O(n) time
+    template <typename ForwardIt>
+    SplayTreeMap(ForwardIt first, ForwardIt last) { Base::build_from_sorted(first, last); }
 };
 
 } // namespace dsac::map
@@ -1,15 +1,24 @@
 #pragma once
 #include <functional>    // defines std::less
+#include <future>        // defines std::async
 #include <stdexcept>
+#include <type_traits>   // defines std::conditional_t, std::is_same_v
+#include <typeinfo>      // supports typeid
 #include <utility>
 #include <vector>
 
+#include "augmentation.h"
 #include "map/abstract_map.h"
 #include "tree/linked_binary_tree.h"
 
 namespace dsac::search_tree {
 
-template <typename Key, typename Value, typename Compare=std::less<Key>>
+/// A sorted map implemented as a binary search tree, serving as the base class for balanced
+/// search trees. Each node also records the size of its subtree, so that entries can be found
+/// by rank. The Augment policy (see augmentation.h) may maintain a further aggregate, such as
+/// the sum or maximum of the values, within each subtree.
+template <typename Key, typename Value, typename Compare=std::less<Key>, typename Nodes=dsac::tree::HeapNodes,
+          typename Augment=NoAugment>
 class TreeMap : public dsac::map::AbstractMap<Key,Value> {
   protected:
     typedef dsac::map::AbstractMap<Key,Value> Base;           // shorthand for the base class
@@ -19,12 +28,31 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
     
   protected:
 
+    static constexpr bool augmented{!std::is_same_v<Augment,NoAugment>};
+
+    // the tree element type, storing an auxiliary int for balancing info and the size of the
+    // subtree, as well as the aggregate of the subtree (if augmented)
+    struct PlainEntry {
+        Entry entry;
+        int aux{0};
+        int size{1};
+
+        PlainEntry() {}
+        explicit PlainEntry(Entry&& e) : entry{std::move(e)} {}
+    };
+    template <typename A>
+    struct AugmentedEntry : PlainEntry {
+        typename A::type total{A::identity()};
+
+        using PlainEntry::PlainEntry;
+    };
+    typedef std::conditional_t<augmented, AugmentedEntry<Augment>, PlainEntry> BSTEntry;
+
     /// ------------ nested BalanceableBinaryTree class -------------------
     /// A specialized version of the LinkedBinaryTree class with additional mutators to
     /// support binary search tree operations, and with the tree element type storing
-    /// an additional auxiliary instance variable for balancing data.
-    typedef std::pair<Entry,int> BSTEntry;                  // include auxiliary int for balancing info
-    typedef dsac::tree::LinkedBinaryTree<BSTEntry> TreeBase;
+    /// additional instance variables for balancing data and subtree sizes.
+    typedef dsac::tree::LinkedBinaryTree<BSTEntry,Nodes> TreeBase;     // Nodes determines node allocation
     class BalanceableBinaryTree : public TreeBase {
       public:
         friend TreeMap;
@@ -33,6 +61,43 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
         // the root node that serves as the end() sentinel
         Node* sentinel() const { return TreeBase::rt; }
 
+        // creates a node storing element e, which is not yet linked to the tree
+        Node* create(BSTEntry&& e) { return TreeBase::nodes.create(std::move(e)); }
+
+        // unlinks and returns the subtree below the sentinel (possibly nullptr)
+        Node* detach_root() {
+            Node* r{sentinel()->left};
+            sentinel()->left = nullptr;
+            if (r != nullptr) r->parent = nullptr;
+            TreeBase::sz = 1;
+            return r;
+        }
+
+        // links the subtree rooted at r, with n nodes, below the sentinel (which must have none)
+        void set_root(Node* r, int n) {
+            relink(sentinel(), r, true);
+            TreeBase::sz = 1 + n;
+        }
+
+        // destroys every node of the detached subtree rooted at nd (possibly nullptr)
+        void destroy_subtree(Node* nd) {
+            if (nd != nullptr) {
+                destroy_subtree(nd->left);
+                destroy_subtree(nd->right);
+                TreeBase::nodes.destroy(nd);
+            }
+        }
+
+        // Takes ownership of the nodes allocated by the other tree, which must have nothing
+        // below its sentinel. As the sentinel may be among them, the other tree is given a
+        // new sentinel of its own, and the old one is destroyed here.
+        void absorb(BalanceableBinaryTree& other) {
+            Node* old_sentinel{other.sentinel()};
+            TreeBase::nodes.absorb(other.nodes);
+            other.rt = other.nodes.create(BSTEntry());
+            TreeBase::nodes.destroy(old_sentinel);
+        }
+
         // link child (possibly nullputr) to the indicated side of the parent
         void relink(Node* parent, Node* child, bool make_left_child) {
             if (make_left_child)
@@ -52,10 +117,15 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
         ///       a  t2             t0   b
         ///      / \                    / \
         ///     t0  t1                 t1  t2
+        ///
+        /// The subtree sizes (and aggregates) of x and y are updated.
         void rotate(Node* x) {
             Node* y = x->parent;         // we assume parent exists within the tree map
-            Node* z = y->parent;         // grandparent (possibly the sentinel)
-            relink(z, x, y == z->left);     // x becomes direct child of z
+            Node* z = y->parent;         // grandparent (possibly the sentinel, or none in a detached subtree)
+            if (z != nullptr)
+                relink(z, x, y == z->left); // x becomes direct child of z
+            else
+                x->parent = nullptr;
             // now rotate x and y, including transfer of middle subtree
             if (x == y->left) {
                 relink(y, x->right, true);  // x's right child becomes y's left child
@@ -64,6 +134,8 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
                 relink(y, x->left, false);  // x's left child becomes y's right child
                 relink(x, y, true);         // y becomes left child of x
             }
+            refresh(y);                     // y is now below x
+            refresh(x);
         }
 
         /// Performs a trinode restructuring of Node x with its parent/grandparent.
@@ -114,21 +186,291 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
     // Rebalances the the tree immediately after the deletion of a child of p
     virtual void rebalance_delete(Node*) { }
 
+    // Sets the balancing data of node p, created by build_from_sorted at the given depth
+    // (where leaves have depth max_depth or max_depth-1) after its children
+    virtual void rebalance_build(Node*, int /*depth*/, int /*max_depth*/) { }
+
+    // Adjusts the balancing data of detached subtree root p (possibly nullptr), which is
+    // about to become the entire tree
+    virtual void rebalance_root(Node*) { }
+
+    // Records any data needed by join_subtrees for p (possibly nullptr), which was just
+    // detached as the entire tree
+    virtual void rebalance_detach(Node*) { }
+
+    // Records any data needed by join_subtrees for left and right (possibly nullptr), which
+    // were just unlinked from detached node t
+    virtual void rebalance_expose(Node* /*t*/, Node* /*left*/, Node* /*right*/) { }
+
+    // Returns the root of a balanced subtree with the nodes of left, then mid, then right,
+    // where left and right are detached subtrees (possibly empty) and mid is a detached node,
+    // with every key of left less than mid's, and mid's less than every key of right. All
+    // other operations on detached subtrees (split, join2) are expressed with this one.
+    // The default simply makes left and right the children of mid.
+    virtual Node* join_subtrees(Node* left, Node* mid, Node* right) { return make_subtree(left, mid, right); }
+
 
     // instance variables for a TreeMap
     BalanceableBinaryTree tree; 
     Compare less_than;                          // determines "a < b" relationship among keys
 
-    Key key(Node* nd) const { return nd->element.first.key(); }
-    int aux(Node* nd) const { return nd->element.second; }
-    void set_aux(Node* nd, int value) { nd->element.second = value; }
+    const Key& key(Node* nd) const { return nd->element.entry.key(); }
+    int aux(Node* nd) const { return nd->element.aux; }
+    void set_aux(Node* nd, int value) { nd->element.aux = value; }
+
+    // Returns the number of entries in the subtree rooted at nd (nullptr is considered 0)
+    static int subtree_size(Node* nd) { return (nd == nullptr ? 0 : nd->element.size); }
+
+    // Recomputes the subtree size (and aggregate) of nd from those of its children
+    static void refresh(Node* nd) {
+        nd->element.size = 1 + subtree_size(nd->left) + subtree_size(nd->right);
+        if constexpr (augmented) {
+            const Entry& e{nd->element.entry};
+            typename Augment::type total{Augment::of(e.key(), e.value())};
+            if (nd->left != nullptr) total = Augment::combine(nd->left->element.total, total);
+            if (nd->right != nullptr) total = Augment::combine(total, nd->right->element.total);
+            nd->element.total = total;
+        }
+    }
+
+    // Refreshes nd and each of its ancestors (other than the end sentinel)
+    void refresh_path(Node* nd) {
+        for (; nd != tree.sentinel(); nd = nd->parent)
+            refresh(nd);
+    }
+
+    // Makes left and right (possibly nullptr) the children of detached node mid, returning mid
+    Node* make_subtree(Node* left, Node* mid, Node* right) {
+        tree.relink(mid, left, true);
+        tree.relink(mid, right, false);
+        mid->parent = nullptr;
+        refresh(mid);
+        return mid;
+    }
+
+    // Unlinks the children of detached node t, setting left and right to them
+    void expose(Node* t, Node*& left, Node*& right) {
+        left = t->left;
+        right = t->right;
+        if (left != nullptr) left->parent = nullptr;
+        if (right != nullptr) right->parent = nullptr;
+        t->left = t->right = nullptr;
+        rebalance_expose(t, left, right);
+    }
+
+    // Unlinks and returns the entire subtree of the given tree (this map's or another of
+    // the same type), for use with the operations on detached subtrees
+    Node* detach(BalanceableBinaryTree& from) {
+        Node* r{from.detach_root()};
+        rebalance_detach(r);
+        return r;
+    }
+
+    // Builds a subtree with the next n entries from the sorted range at walk (which is
+    // advanced past them), with its root at the given depth, and returns its root
+    template <typename InputIt>
+    Node* build(InputIt& walk, int n, int depth, int max_depth) {
+        if (n == 0) return nullptr;
+        Node* left{build(walk, (n - 1) / 2, depth + 1, max_depth)};
+        Node* mid{tree.create(BSTEntry{Entry(walk->first, walk->second)})};
+        ++walk;
+        Node* right{build(walk, n - 1 - (n - 1) / 2, depth + 1, max_depth)};
+        make_subtree(left, mid, right);
+        rebalance_build(mid, depth, max_depth);
+        return mid;
+    }
+
+    // Replaces the (empty) tree with a perfectly balanced one built from the (key, value)
+    // pairs in the range [first, last), which must have strictly increasing keys
+    template <typename ForwardIt>
+    void build_from_sorted(ForwardIt first, ForwardIt last) {
+        int n{0};
+        for (ForwardIt walk = first, prior = first; walk != last; prior = walk, ++walk, n++)
+            if (n > 0 && !less_than(prior->first, walk->first))
+                throw std::invalid_argument("build_from_sorted requires keys in increasing order");
+        int max_depth{0};
+        while ((2L << max_depth) - 1 < n) max_depth++;          // a full tree of this depth holds n
+        tree.set_root(build(first, n, 0, max_depth), n);
+    }
+
+    // Splits detached subtree t into detached subtrees left and right, with the keys less
+    // than and greater than k, respectively. Returns the (detached) node with key k if one
+    // exists, or else nullptr.
+    Node* split_subtree(Node* t, const Key& k, Node*& left, Node*& right) {
+        if (t == nullptr) {
+            left = right = nullptr;
+            return nullptr;
+        }
+        Node *l, *r, *found{t};
+        expose(t, l, r);
+        if (less_than(k, key(t))) {                                       // k is to the left
+            found = split_subtree(l, k, left, l);
+            right = join_subtrees(l, t, r);
+        } else if (less_than(key(t), k)) {                                // k is to the right
+            found = split_subtree(r, k, r, right);
+            left = join_subtrees(l, t, r);
+        } else {
+            left = l;
+            right = r;
+            refresh(t);
+        }
+        return found;
+    }
+
+    // Removes the last node (in order) of detached subtree t into last, returning the rest
+    Node* split_last(Node* t, Node*& last) {
+        Node *l, *r;
+        expose(t, l, r);
+        if (r == nullptr) {
+            refresh(t);
+            last = t;
+            return l;
+        }
+        return join_subtrees(l, t, split_last(r, last));
+    }
+
+    // Returns a balanced subtree with the nodes of detached subtrees left and right, where
+    // every key of left is less than every key of right
+    Node* join2(Node* left, Node* right) {
+        if (left == nullptr) return right;
+        Node* last;
+        Node* rest{split_last(left, last)};
+        return join_subtrees(rest, last, right);
+    }
+
+    // set operations fork a thread only if the subtrees involved hold at least this many entries
+    static constexpr int parallel_grain{1 << 12};
+
+    // Returns the results of task(l1, l2, threads) and task(r1, r2, threads), with the
+    // threads divided between the two calls when there is more than one and the subtrees
+    // are large enough to be worth a thread of their own
+    template <typename Task>
+    static std::pair<Node*,Node*> fork_join(Task& task, Node* l1, Node* l2, Node* r1, Node* r2, int threads) {
+        if (threads < 2 || subtree_size(l1) + subtree_size(l2) < parallel_grain
+                        || subtree_size(r1) + subtree_size(r2) < parallel_grain)
+            return {task(l1, l2, 1), task(r1, r2, 1)};
+        auto left{std::async(std::launch::async, [&] { return task(l1, l2, threads / 2); })};
+        Node* right{task(r1, r2, threads - threads / 2)};
+        return {left.get(), right};
+    }
+
+    // Returns the union of detached subtrees t1 and t2 (consuming both), with the value for
+    // a key of both being merge(v1, v2); nodes of t1 are kept for such keys
+    template <typename Merge>
+    Node* unite_subtrees(Node* t1, Node* t2, Merge& merge, int threads) {
+        if (t1 == nullptr) return t2;
+        if (t2 == nullptr) return t1;
+        Node *l1, *r1, *l2, *r2;
+        expose(t2, l2, r2);
+        Node* found{split_subtree(t1, key(t2), l1, r1)};
+        auto task{[&](Node* a, Node* b, int th) { return unite_subtrees(a, b, merge, th); }};
+        auto [left, right]{fork_join(task, l1, l2, r1, r2, threads)};
+        if (found == nullptr) return join_subtrees(left, t2, right);
+        Value& v{found->element.entry.value()};
+        v = merge(std::move(v), std::move(t2->element.entry.value()));
+        tree.destroy_subtree(t2);
+        return join_subtrees(left, found, right);
+    }
+
+    // Returns the intersection of detached subtrees t1 and t2 (consuming both), with the
+    // value for each key being merge(v1, v2)
+    template <typename Merge>
+    Node* intersect_subtrees(Node* t1, Node* t2, Merge& merge, int threads) {
+        if (t1 == nullptr || t2 == nullptr) {
+            tree.destroy_subtree(t1);
+            tree.destroy_subtree(t2);
+            return nullptr;
+        }
+        Node *l1, *r1, *l2, *r2;
+        expose(t2, l2, r2);
+        Node* found{split_subtree(t1, key(t2), l1, r1)};
+        auto task{[&](Node* a, Node* b, int th) { return intersect_subtrees(a, b, merge, th); }};
+        auto [left, right]{fork_join(task, l1, l2, r1, r2, threads)};
+        if (found == nullptr) {
+            tree.destroy_subtree(t2);
+            return join2(left, right);
+        }
+        Value& v{found->element.entry.value()};
+        v = merge(std::move(v), std::move(t2->element.entry.value()));
+        tree.destroy_subtree(t2);
+        return join_subtrees(left, found, right);
+    }
+
+    // Returns the entries of detached subtree t1 whose keys are not in detached subtree t2
+    // (consuming both)
+    Node* subtract_subtrees(Node* t1, Node* t2, int threads) {
+        if (t1 == nullptr || t2 == nullptr) {
+            tree.destroy_subtree(t2);
+            return t1;
+        }
+        Node *l1, *r1, *l2, *r2;
+        expose(t2, l2, r2);
+        Node* found{split_subtree(t1, key(t2), l1, r1)};
+        tree.destroy_subtree(found);
+        tree.destroy_subtree(t2);
+        auto task{[&](Node* a, Node* b, int th) { return subtract_subtrees(a, b, th); }};
+        auto [left, right]{fork_join(task, l1, l2, r1, r2, threads)};
+        return join2(left, right);
+    }
+
+    // Detaches the trees of this map and other, and replaces this map's tree with the result
+    // of combine(t1, t2), leaving other empty
+    template <typename Combine>
+    void combine_with(TreeMap& other, int threads, Combine combine) {
+        static_assert(!Nodes::template Allocator<Node>::releases_in_bulk, "set operations require individually allocated nodes");
+        check_compatible(other);
+        if (threads < 1)
+            throw std::invalid_argument("number of threads must be positive");
+        Node* t2{detach(other.tree)};
+        Node* root{combine(detach(tree), t2, threads)};
+        rebalance_root(root);
+        tree.set_root(root, subtree_size(root));
+    }
+
+    // Throws invalid_argument unless other is a distinct map of the same type as this one
+    void check_compatible(const TreeMap& other) const {
+        if (&other == this || typeid(other) != typeid(*this))
+            throw std::invalid_argument("requires another map of the same type");
+    }
+
+    // Returns the number of entries whose keys satisfy go_left (which must hold for a
+    // prefix of the keys in order)
+    template <typename GoLeft>
+    int count_prefix(GoLeft go_left) const {
+        int result{0};
+        Node* walk = tree.rt->left;
+        while (walk != nullptr) {
+            if (go_left(key(walk))) {
+                result += subtree_size(walk->left) + 1;
+                walk = walk->right;
+            } else {
+                walk = walk->left;
+            }
+        }
+        return result;
+    }
+
+    // Returns the aggregate of the entries with keys in range [a, b] within the subtree at
+    // nd, where has_a (or has_b) is false if the subtree has no keys less than a (or greater
+    // than b). Only two paths are followed, as any subtree entirely within the range
+    // contributes its stored aggregate.
+    template <typename A = Augment>
+    typename A::type total_in(Node* nd, const Key& a, const Key& b, bool has_a, bool has_b) const {
+        if (nd == nullptr) return A::identity();
+        if (!has_a && !has_b) return nd->element.total;
+        if (has_a && less_than(key(nd), a)) return total_in(nd->right, a, b, has_a, has_b);
+        if (has_b && less_than(b, key(nd))) return total_in(nd->left, a, b, has_a, has_b);
+        const Entry& e{nd->element.entry};
+        return A::combine(A::combine(total_in(nd->left, a, b, has_a, false), A::of(e.key(), e.value())),
+                          total_in(nd->right, a, b, false, has_b));
+    }
     
-    bool equals(Key a, Key b) const {           // equality based on the less_than comparator
+    bool equals(const Key& a, const Key& b) const {           // equality based on the less_than comparator
         return (!less_than(a,b) && !less_than(b,a));
     }
    
     // Return pointer to node storing key k, or the last node on a failed search
-    Node* search(Key k) const {
+    Node* search(const Key& k) const {
         if (empty()) return tree.rt;
         Node* walk = tree.rt->left;                      // start to the left of end sentinel
         while (true) {
@@ -158,17 +500,33 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
             return p;
         }
     }
+
+    // return the inorder predecessor of position p (where the end sentinel precedes the last entry)
+    static Node* predecessor(Node* p)  {
+        if (p->left == nullptr) {          // no left subtree so look upward
+            while (p == p->parent->left)
+                p = p->parent;
+            return p->parent;      // original p was min of right subtree of returned
+        } else {
+            // find largest entry in left subtree
+            p = p->left;
+            while (p->right != nullptr)
+                p = p->right;
+            return p;
+        }
+    }
         
     // a position within our map is described by a node pointer
-    using typename Base::abstract_iter_rep, Base::get_rep;
-    class iter_rep : public abstract_iter_rep {              // specialize abstract version
+    using typename Base::abstract_iter_rep;
+    using Base::get_rep, Base::make_iterator;
+    class iter_rep : public Base::template iter_rep_base<iter_rep> {    // specialize abstract version
       public:
         Node* node;
         iter_rep(Node* nd) : node{nd} {}
 
-        const Entry& entry() const { return node->element.first; }
+        const Entry& entry() const { return node->element.entry; }
         void advance() { node = successor(node); }
-        abstract_iter_rep* clone() const { return new iter_rep(node); }
+        void retreat() { node = predecessor(node); }
         bool equals(const abstract_iter_rep* other) const {
             const iter_rep* p = dynamic_cast<const iter_rep*>(other);   // cast abstract argument to our iter_rep
             return p != nullptr && node == p->node;
@@ -180,6 +538,11 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
     TreeMap() {
         tree.add_root();            // root serves as our end() position; entry irrelevant
     }
+
+    /// Creates a map with the (key, value) pairs in the range [first, last), which must have
+    /// strictly increasing keys (or else invalid_argument is thrown), in O(n) time
+    template <typename ForwardIt>
+    TreeMap(ForwardIt first, ForwardIt last) : TreeMap() { build_from_sorted(first, last); }
     
     /// Returns the number of entries in the map
     int size() const { return tree.size() - 1;  }   // disregard the end sentinel
@@ -189,11 +552,11 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
         Node* walk = tree.sentinel();
         while (walk->left != nullptr)
             walk = walk->left;
-        return const_iterator(new iter_rep(walk));
+        return make_iterator(iter_rep(walk));
     }
 
     /// Returns a const_iterator representing the end
-    const_iterator end() const { return const_iterator(new iter_rep(tree.rt)); }
+    const_iterator end() const { return make_iterator(iter_rep(tree.rt)); }
 
     /// Returns a const_iterator to the entry with a given key, or end() if no such entry exists
     const_iterator find(const Key& k) const {
@@ -201,56 +564,180 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
         Node* p{search(k)};
         const_cast<TreeMap*>(this)->rebalance_access(p);                  // find could trigger rebalance of tree
         if (equals(k, key(p)))                                            // exact match
-            return const_iterator(new iter_rep(p));
+            return make_iterator(iter_rep(p));
         else                                                              // unsuccessful search
             return end();
     }
 
-    /// Associates given key with given value. If key already exists previous value is overwritten.
-    /// Returns a const_iterator to the entry associated with the key
-    const_iterator put(const Key& k, const Value& v) {
+  protected:
+    // add/update Entry(k,v), copying or moving k and v as given
+    template <typename K, typename V>
+    const_iterator insert(K&& k, V&& v) {
         Node* p{search(k)};
         if (p != tree.rt && equals(k, key(p))) {                          // exact match
-            p->element.first.value() = v;                                 // update entry's value
+            p->element.entry.value() = std::forward<V>(v);                // update entry's value
+            if constexpr (augmented) refresh_path(p);
             rebalance_access(p);
         } else {                                                          // unsuccessful search
-            if (p == tree.rt || less_than(k, key(p))) {
-                tree.add_left(Position(p), {{k,v},0});
+            bool left{p == tree.rt || less_than(k, key(p))};
+            BSTEntry element{Entry(std::forward<K>(k), std::forward<V>(v))};
+            if (left) {
+                tree.add_left(Position(p), std::move(element));
                 p = p->left;
             } else {
-                tree.add_right(Position(p), {{k,v},0});
+                tree.add_right(Position(p), std::move(element));
                 p = p->right;
             }
+            refresh_path(p);                                              // sizes along path grow
             rebalance_insert(p);
         }
-        return const_iterator(new iter_rep(p));
+        return make_iterator(iter_rep(p));
     }
 
+    // refreshes the aggregates above an entry whose value upsert has changed in place
+    void value_updated(const const_iterator& it) override {
+        if constexpr (augmented) refresh_path(dynamic_cast<iter_rep*>(get_rep(it))->node);
+    }
+
+  public:
+    /// Associates given key with given value. If key already exists previous value is overwritten.
+    /// Returns a const_iterator to the entry associated with the key
+    const_iterator put(const Key& k, const Value& v) { return insert(k, v); }
+
+    /// Same as above, but moving the key and value into the map
+    const_iterator put(Key&& k, Value&& v) { return insert(std::move(k), std::move(v)); }
+
     /// Removes the entry indicated by the given iterator, and returns const_iterator to next entry in iteration order
     const_iterator erase(const_iterator loc) {
         Node* p = dynamic_cast<iter_rep*>(get_rep(loc))->node;
+        Node* after = successor(p);                              // found before any entry moves
         if (p->left != nullptr && p->right != nullptr) {         // p has two children
             Node* before = p->left;
             while (before->right != nullptr)
                 before = before->right;
-            p->element.first = before->element.first;            // move predecessor's entry to p
+            p->element.entry = std::move(before->element.entry); // move predecessor's entry to p
             p = before;                                          // and now consider deleting predecessor
         }
         // now p has at most one child
         Node* parent = p->parent;
-        Node* after = successor(p);
         tree.erase(Position(p));                                 // inherited from LinkedBinaryTree
+        refresh_path(parent);                                    // sizes along path shrink
         rebalance_delete(parent);
-        return const_iterator(new iter_rep(after));
+        return make_iterator(iter_rep(after));
     }
     
+    /// Returns a const_iterator to the entry with the given rank (that is, with exactly j
+    /// smaller keys), or throws out_of_range if j is not in the range 0 to size()-1
+    const_iterator select(int j) const {
+        if (j < 0 || j >= size())
+            throw std::out_of_range("rank out of range");
+        Node* walk = tree.rt->left;
+        while (j != subtree_size(walk->left)) {
+            if (j < subtree_size(walk->left)) {
+                walk = walk->left;
+            } else {
+                j -= subtree_size(walk->left) + 1;
+                walk = walk->right;
+            }
+        }
+        return make_iterator(iter_rep(walk));
+    }
+
+    /// Returns the number of entries with key strictly less than k
+    int rank(const Key& k) const { return count_prefix([&](const Key& key) { return less_than(key, k); }); }
+
+    /// Returns the number of entries with keys in the range [a, b]
+    int count_range(const Key& a, const Key& b) const {
+        if (less_than(b, a)) return 0;
+        return count_prefix([&](const Key& key) { return !less_than(b, key); }) - rank(a);
+    }
+
+    /// Returns the aggregate (as defined by the Augment policy) of the entries with keys in
+    /// the range [a, b]; only available if the map is augmented
+    template <typename A = Augment>
+    typename A::type aggregate(const Key& a, const Key& b) const {
+        static_assert(augmented, "aggregate requires an Augment policy");
+        if (less_than(b, a)) return A::identity();
+        return total_in(tree.rt->left, a, b, true, true);
+    }
+
+    /// Returns the aggregate of all entries; only available if the map is augmented
+    template <typename A = Augment>
+    typename A::type aggregate() const {
+        static_assert(augmented, "aggregate requires an Augment policy");
+        return (empty() ? A::identity() : tree.rt->left->element.total);
+    }
+
+    /// Moves the entries with keys greater than or equal to k into map greater, which must
+    /// be an empty map of the same type. Takes time proportional to the height of the tree.
+    void split(const Key& k, TreeMap& greater) {
+        static_assert(!Nodes::template Allocator<Node>::releases_in_bulk, "split requires individually allocated nodes");
+        check_compatible(greater);
+        if (!greater.empty())
+            throw std::invalid_argument("split requires an empty map to receive entries");
+        Node *left, *right;
+        Node* found{split_subtree(detach(tree), k, left, right)};
+        if (found != nullptr)
+            right = join_subtrees(nullptr, found, right);
+        rebalance_root(left);
+        rebalance_root(right);
+        tree.set_root(left, subtree_size(left));
+        greater.tree.set_root(right, subtree_size(right));
+    }
+
+    /// Moves all entries of map greater, which must be of the same type and have only keys
+    /// greater than those of this map, into this map, leaving greater empty. Takes time
+    /// proportional to the heights of the trees.
+    void join(TreeMap& greater) {
+        check_compatible(greater);
+        if (greater.empty()) return;
+        if (!empty()) {
+            Node* last{predecessor(tree.sentinel())};
+            Node* first{greater.tree.sentinel()->left};
+            while (first->left != nullptr)
+                first = first->left;
+            if (!less_than(key(last), key(first)))
+                throw std::invalid_argument("join requires keys greater than those of this map");
+        }
+        int n{size() + greater.size()};
+        Node* right{detach(greater.tree)};
+        tree.absorb(greater.tree);                               // pooled nodes change hands
+        Node* root{join2(detach(tree), right)};
+        rebalance_root(root);
+        tree.set_root(root, n);
+    }
+
+    /// Moves every entry of other, which must be a map of the same type, into this map,
+    /// leaving other empty. For a key of both maps, the value becomes merge(mine, theirs)
+    /// (with both values passed as rvalues). For maps of sizes m <= n with balanced trees,
+    /// this takes O(m log(n/m + 1)) time, and independent subtrees are combined in parallel
+    /// when more than one thread is allowed; merge must then be safe to call concurrently.
+    template <typename Merge>
+    void unite(TreeMap& other, Merge merge, int threads = 1) {
+        combine_with(other, threads, [&](Node* t1, Node* t2, int th) { return unite_subtrees(t1, t2, merge, th); });
+    }
+
+    /// Keeps only the entries of this map whose keys are also in other, with the value
+    /// for each becoming merge(mine, theirs), and leaves other empty. Time and threading
+    /// are as for unite.
+    template <typename Merge>
+    void intersect(TreeMap& other, Merge merge, int threads = 1) {
+        combine_with(other, threads, [&](Node* t1, Node* t2, int th) { return intersect_subtrees(t1, t2, merge, th); });
+    }
+
+    /// Removes the entries of this map whose keys are in other, leaving other empty. Time
+    /// and threading are as for unite.
+    void subtract(TreeMap& other, int threads = 1) {
+        combine_with(other, threads, [&](Node* t1, Node* t2, int th) { return subtract_subtrees(t1, t2, th); });
+    }
+
     /// Returns a const_iterator to the first entry with key greater than or equal to k, or end() if no such entry exists
     const_iterator lower_bound(const Key& k) const {
         if (empty()) return end();
         Node* p{search(k)};
         if (less_than(key(p), k))      // unsuccessful search ended at leaf with smaller key
             p = successor(p);
-        return const_iterator(new iter_rep(p));
+        return make_iterator(iter_rep(p));
     }
     
     /// Returns a const_iterator to the first entry with key strictly greater than k, or end() if no such entry exists
@@ -259,13 +746,13 @@ class TreeMap : public dsac::map::AbstractMap<Key,Value> {
         Node* p{search(k)};
         if (!less_than(k, key(p)))     // need entry with strictly greater key
             p = successor(p);
-        return const_iterator(new iter_rep(p));
+        return make_iterator(iter_rep(p));
     }
 
 
     //----------- remainder for debugging only -----------
     static void _dumpNode(Node* p)  {
-        std::cout << p->element.first.key() << "(" << p->element.second << "):" << p->element.first.value();
+        std::cout << p->element.entry.key() << "(" << p->element.aux << "):" << p->element.entry.value();
     }
     
     static void _dump(Node* p, int depth) {
@@ -1,10 +1,16 @@
 #pragma once
+#include <type_traits> // defines std::is_trivially_destructible
+#include <utility>    // defines std::move
 #include "tree.h"
 #include "binary_tree.h"
+#include "node_allocation.h"
 
 namespace dsac::tree {
 
-template <typename E>
+/// A binary tree with linked nodes. The Nodes policy (see node_allocation.h) determines
+/// how nodes are allocated: individually from the heap (HeapNodes), or from slabs owned by
+/// the tree (PooledNodes).
+template <typename E, typename Nodes = HeapNodes>
 class LinkedBinaryTree {
   protected:
     //------ nested Node class ------
@@ -15,10 +21,11 @@ class LinkedBinaryTree {
         Node* left{nullptr};
         Node* right{nullptr};
 
-        Node(E e, Node* p = nullptr) : element{e}, parent{p} {}
+        Node(E e, Node* p = nullptr) : element{std::move(e)}, parent{p} {}
     };  // end of Node class
 
     //------ data members of LinkedBinaryTree ------
+    typename Nodes::template Allocator<Node> nodes;     // declared first, as clone uses it
     Node* rt{nullptr};
     int sz{0};
 
@@ -84,21 +91,33 @@ class LinkedBinaryTree {
 
     /// Creates a root for an empty tree, storing e as the element; should never be called on non-empty tree
     void add_root(const E& e = E()) {  // add root to (presumed) empty tree
-        rt = new Node(e);
+        rt = nodes.create(e);
         sz = 1;
     }
 
     /// Creates a new node storing element e, and links the new node as the left child of position p.
     /// Should not be called if p already has a (non-null) left child.
     void add_left(Position p, const E& e) {
-        p.node->left = new Node{e, p.node};           // parent of new node is p's node
+        p.node->left = nodes.create(e, p.node);           // parent of new node is p's node
+        sz++;
+    }
+
+    /// Same as above, but moving element e into the new node
+    void add_left(Position p, E&& e) {
+        p.node->left = nodes.create(std::move(e), p.node);
         sz++;
     }
     
     /// Creates a new node storing element e, and links the new node as the right child of position p.
     /// Should not be called if p already has a (non-null) right child.
     void add_right(Position p, const E& e) {
-        p.node->right = new Node{e, p.node};          // parent of new node is p's node
+        p.node->right = nodes.create(e, p.node);          // parent of new node is p's node
+        sz++;
+    }
+
+    /// Same as above, but moving element e into the new node
+    void add_right(Position p, E&& e) {
+        p.node->right = nodes.create(std::move(e), p.node);
         sz++;
     }
     
@@ -118,7 +137,7 @@ class LinkedBinaryTree {
         else                                 // node is right child of its parent
             nd->parent->right = child;
         sz--;
-        delete nd;
+        nodes.destroy(nd);
     }
 
     
@@ -134,6 +153,10 @@ class LinkedBinaryTree {
         if (left.rt) left.rt->parent = nd;
         if (right.rt) right.rt->parent = nd;
 
+        // nodes of the other trees now belong to this one
+        nodes.absorb(left.nodes);
+        nodes.absorb(right.nodes);
+
         // reset other trees to an empty state
         left.sz = right.sz = 0;
         left.rt = right.rt = nullptr;
@@ -142,18 +165,27 @@ class LinkedBinaryTree {
     
   // ------------- Rule of five support ----------------
   private:
-    void tear_down(Node* nd) {
+    // Destroys the subtree rooted at nd
+    void destroy_subtree(Node* nd) {
         if (nd != nullptr) {
-            tear_down(nd->left);
-            tear_down(nd->right);
-            delete nd;
+            destroy_subtree(nd->left);
+            destroy_subtree(nd->right);
+            nodes.destroy(nd);
         }
     }
 
+    // Destroys the entire tree, rooted at nd; when the allocator can release all nodes
+    // at once and elements need no destructor, the nodes are not visited individually
+    void tear_down(Node* nd) {
+        if constexpr (!(Nodes::template Allocator<Node>::releases_in_bulk && std::is_trivially_destructible_v<E>))
+            destroy_subtree(nd);
+        nodes.release();
+    }
+
     // Create cloned structure of model and return pointer to the new structure
-    static Node* clone(Node* model) {
+    Node* clone(Node* model) {
         if (model == nullptr) return nullptr;        // trivial clone
-        Node* new_root{new Node(model->element)};
+        Node* new_root{nodes.create(model->element)};
         new_root->left = clone(model->left);
         if (new_root->left) new_root->left->parent = new_root;
         new_root->right = clone(model->right);
@@ -166,7 +198,7 @@ class LinkedBinaryTree {
     ~LinkedBinaryTree() { tear_down(rt); }
 
     // copy constructor
-    LinkedBinaryTree(const LinkedBinaryTree& other) : sz{other.sz}, rt{clone(other.rt)} {}
+    LinkedBinaryTree(const LinkedBinaryTree& other) : rt{clone(other.rt)}, sz{other.sz} {}
 
     // copy assignment
     LinkedBinaryTree& operator=(const LinkedBinaryTree& other) {
@@ -179,7 +211,7 @@ class LinkedBinaryTree {
     }
 
     // move constructor
-    LinkedBinaryTree(LinkedBinaryTree&& other) : sz{other.sz}, rt{other.rt} {
+    LinkedBinaryTree(LinkedBinaryTree&& other) : nodes{std::move(other.nodes)}, rt{other.rt}, sz{other.sz} {
         // reset other to empty
         other.sz = 0;
         other.rt = nullptr;
@@ -191,6 +223,7 @@ class LinkedBinaryTree {
             using std::swap;
             swap(sz, other.sz);
             swap(rt, other.rt);      // old structure will be destroyed by other
+            swap(nodes, other.nodes);
         }
         return *this;
     }
@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>      // defines std::min
+#include <iterator>       // defines std::make_move_iterator
+#include <memory>         // defines std::unique_ptr
+#include <new>            // provides placement new
+#include <utility>        // defines std::forward, std::swap
+#include <vector>
+
+namespace dsac::tree {
+
+// Policies for how a LinkedBinaryTree obtains and releases its nodes. Each policy provides
+// a nested Allocator<Node> class, one instance of which is owned by each tree, with
+//
+//     create(args...)    constructs a new Node with the given arguments
+//     destroy(nd)        destroys a Node previously returned by create
+//     release()          frees all memory, for use once every node has been destroyed (or
+//                        without destroying nodes at all, if releases_in_bulk is true and
+//                        the nodes need no destructor)
+//     absorb(other)      takes ownership of nodes created by another tree's allocator
+
+/// Allocates each node individually with new and delete (the default)
+struct HeapNodes {
+    template <typename Node>
+    class Allocator {
+      public:
+        static constexpr bool releases_in_bulk{false};
+
+        template <typename... Args>
+        Node* create(Args&&... args) { return new Node(std::forward<Args>(args)...); }
+        void destroy(Node* nd) { delete nd; }
+        void release() { }
+        void absorb(Allocator&) { }
+    };
+};
+
+/// Carves nodes from large slabs owned by the tree, so that consecutive insertions are
+/// placed close together in memory and most insertions require no call to the global
+/// allocator. Erased nodes are kept on a free list for reuse. All slabs are freed together
+/// when the tree is destroyed, and if the nodes need no destructor, this happens without
+/// visiting the nodes at all, taking time proportional to the number of slabs.
+struct PooledNodes {
+    template <typename Node>
+    class Allocator {
+      private:
+        union Slot {                                     // storage for one node
+            Slot* next;                                  // link while on the free list
+            alignas(Node) unsigned char bytes[sizeof(Node)];
+        };
+        static constexpr int first_slab{64};             // capacity of first slab
+        static constexpr int largest_slab{1 << 16};      // slab capacities double up to this
+
+        std::vector<std::unique_ptr<Slot[]>> slabs;      // the last slab is the newest
+        int capacity{0};                                 // capacity of newest slab
+        int used{0};                                     // slots of newest slab handed out
+        Slot* free_list{nullptr};                        // previously destroyed nodes
+
+      public:
+        static constexpr bool releases_in_bulk{true};
+
+        Allocator() {}
+        Allocator(const Allocator&) = delete;            // nodes belong to one tree
+        Allocator& operator=(const Allocator&) = delete;
+        Allocator(Allocator&& other) { swap(other); }
+        Allocator& operator=(Allocator&& other) { swap(other); return *this; }
+
+        void swap(Allocator& other) {
+            std::swap(slabs, other.slabs);
+            std::swap(capacity, other.capacity);
+            std::swap(used, other.used);
+            std::swap(free_list, other.free_list);
+        }
+
+        template <typename... Args>
+        Node* create(Args&&... args) {
+            Slot* place;
+            if (free_list != nullptr) {                  // reuse a destroyed node
+                place = free_list;
+                free_list = free_list->next;
+            } else {
+                if (used == capacity) {                  // start a new slab
+                    capacity = (capacity == 0 ? first_slab : std::min(2 * capacity, largest_slab));
+                    slabs.emplace_back(new Slot[capacity]);
+                    used = 0;
+                }
+                place = &slabs.back()[used++];
+            }
+            return new (place) Node(std::forward<Args>(args)...);
+        }
+
+        void destroy(Node* nd) {
+            nd->~Node();
+            Slot* place{reinterpret_cast<Slot*>(nd)};
+            place->next = free_list;
+            free_list = place;
+        }
+
+        void release() {
+            slabs.clear();
+            capacity = used = 0;
+            free_list = nullptr;
+        }
+
+        // The other allocator's slabs become ours (placed before our newest slab). Its
+        // unused slots are not reused, but are freed along with our own.
+        void absorb(Allocator& other) {
+            if (other.slabs.empty()) return;
+            slabs.insert(slabs.begin(), std::make_move_iterator(other.slabs.begin()),
+                         std::make_move_iterator(other.slabs.end()));
+            other.slabs.clear();
+            other.capacity = other.used = 0;
+            other.free_list = nullptr;
+        }
+    };
+};
+
+}  // namespace dsac::tree